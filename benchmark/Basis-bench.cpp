@@ -4,6 +4,7 @@
 #include <benchmark/benchmark.h>
 
 #include "BasisFilter.h"
+#include "BasisRange.h"
 #include "BosonicBasis.h"
 #include "FermionicBasis.h"
 #include "GenericBasis.h"
@@ -40,6 +41,21 @@ static void BM_CreateBosonicBasis(benchmark::State& state) {
 
 BENCHMARK(BM_CreateBosonicBasis)->ArgsProduct({basis_range, basis_range});
 
+static void BM_IterateFermionicBasisRange(benchmark::State& state) {
+  for (auto _ : state) {
+    FermionicBasisRange range(
+        /*orbitals*/ state.range(0), /*particles*/ state.range(1));
+    std::size_t count = 0;
+    for (const auto& element : range) {
+      count += element.size();
+    }
+    benchmark::DoNotOptimize(count);
+  }
+}
+
+BENCHMARK(BM_IterateFermionicBasisRange)
+    ->ArgsProduct({basis_range, basis_range});
+
 class ZeroTotalSpinFilter : public BasisFilter {
  public:
   bool filter(const BasisElement& element) const override {
@@ -86,3 +102,24 @@ static void BM_CreateBosonicBasisWithFilter(benchmark::State& state) {
 
 BENCHMARK(BM_CreateBosonicBasisWithFilter)
     ->ArgsProduct({basis_range, basis_range});
+
+static void BM_SortFermionicBasis(benchmark::State& state) {
+  for (auto _ : state) {
+    state.PauseTiming();
+    FermionicBasis basis(
+        /*orbitals*/ state.range(0), /*particles*/ state.range(1));
+    state.ResumeTiming();
+    // Reverse the canonical order, which moves every element.
+    basis.sort([](const BasisElement& a, const BasisElement& b) {
+      return std::lexicographical_compare(
+          b.begin(), b.end(), a.begin(), a.end(),
+          [](const Operator& x, const Operator& y) {
+            return x.identifier() < y.identifier();
+          });
+    });
+    benchmark::DoNotOptimize(basis);
+  }
+}
+
+BENCHMARK(BM_SortFermionicBasis)
+    ->ArgsProduct({benchmark::CreateDenseRange(12, 16, 2), {6, 8}});
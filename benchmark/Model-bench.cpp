@@ -3,8 +3,12 @@
 
 #include <benchmark/benchmark.h>
 
+#include "BlockLanczos.h"
+#include "Davidson.h"
 #include "FermionicBasis.h"
 #include "Models/HubbardChain.h"
+#include "ObservableSet.h"
+#include "SeparableMatrix.h"
 #include "SparseMatrix.h"
 
 static auto basis_range = benchmark::CreateDenseRange(8, 12, 2);
@@ -27,3 +31,135 @@ static void BM_CreateHubbardChainMatrixElements(benchmark::State& state) {
 
 BENCHMARK(BM_CreateHubbardChainMatrixElements)
     ->ArgsProduct({basis_range, basis_range});
+
+static void BM_ApplyHubbardChain(benchmark::State& state) {
+  const std::size_t size = state.range(0);
+  const std::size_t particles = state.range(1);
+  HubbardChain model(1.0, 2.0, size);
+  FermionicBasis basis(size, particles);
+  std::vector<std::complex<double>> x(basis.size(), 1.0);
+  std::vector<std::complex<double>> y(basis.size());
+  for (auto _ : state) {
+    model.apply(basis, x, y);
+    benchmark::DoNotOptimize(y.data());
+  }
+}
+
+BENCHMARK(BM_ApplyHubbardChain)->ArgsProduct({basis_range, basis_range});
+
+static void BM_SweepHubbardChain(benchmark::State& state) {
+  const std::size_t size = state.range(0);
+  const std::size_t particles = state.range(1);
+  FermionicBasis basis(size, particles);
+  SeparableMatrix separable(HubbardChain(1.0, 0.0, size), basis);
+  for (auto _ : state) {
+    for (double u = 0.0; u < 10.0; u += 1.0) {
+      benchmark::DoNotOptimize(
+          separable.assemble(HubbardChain(1.0, u, size)).values().data());
+    }
+  }
+}
+
+BENCHMARK(BM_SweepHubbardChain)->ArgsProduct({basis_range, basis_range});
+
+static void BM_AssembleHubbardChain(benchmark::State& state) {
+  const std::size_t size = state.range(0);
+  const std::size_t particles = state.range(1);
+  HubbardChain model(1.0, 2.0, size);
+  FermionicBasis basis(size, particles);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(model.matrix(basis).values().data());
+  }
+}
+
+BENCHMARK(BM_AssembleHubbardChain)->ArgsProduct({basis_range, basis_range});
+
+static void BM_AssembleHermitianHubbardChain(benchmark::State& state) {
+  const std::size_t size = state.range(0);
+  const std::size_t particles = state.range(1);
+  HubbardChain model(1.0, 2.0, size);
+  FermionicBasis basis(size, particles);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(
+        model.hermitian_matrix(basis).upper().values().data());
+  }
+}
+
+BENCHMARK(BM_AssembleHermitianHubbardChain)
+    ->ArgsProduct({basis_range, basis_range});
+
+// Ground state of an 8-site chain at half filling. Argument: U.
+static void BM_GroundStateLanczos(benchmark::State& state) {
+  HubbardChain model(1.0, static_cast<double>(state.range(0)), 8);
+  FermionicBasis basis(8, 8);
+  LinearOperator op(model, basis);
+  for (auto _ : state) {
+    EigenResult result = block_lanczos(op);
+    state.counters["products"] = static_cast<double>(result.applications);
+  }
+}
+
+BENCHMARK(BM_GroundStateLanczos)->Arg(4)->Arg(40);
+
+static void BM_GroundStateDavidson(benchmark::State& state) {
+  HubbardChain model(1.0, static_cast<double>(state.range(0)), 8);
+  FermionicBasis basis(8, 8);
+  LinearOperator op(model, basis);
+  for (auto _ : state) {
+    EigenResult result = davidson(op);
+    state.counters["products"] = static_cast<double>(result.applications);
+  }
+}
+
+BENCHMARK(BM_GroundStateDavidson)->Arg(4)->Arg(40);
+
+// The correlators <S_i . S_j> for all pairs of sites; measured below on an
+// 8-site chain at half filling.
+static std::vector<Expression> spin_correlators(std::size_t sites) {
+  constexpr auto Fermion = Operator::Statistics::Fermion;
+  constexpr auto Up = Operator::Spin::Up;
+  constexpr auto Down = Operator::Spin::Down;
+  std::vector<Expression> result;
+  for (std::size_t i = 0; i < sites; i++) {
+    for (std::size_t j = 0; j < sites; j++) {
+      std::vector<Term> terms;
+      for (auto s : {Up, Down}) {
+        for (auto t : {Up, Down}) {
+          const double sign = s == t ? 0.25 : -0.25;
+          terms.push_back(density_density<Fermion>(sign, s, i, t, j));
+        }
+      }
+      terms.push_back(two_body<Fermion>(0.5, Up, i, Down, i, Down, j, Up, j));
+      terms.push_back(two_body<Fermion>(0.5, Down, i, Up, i, Up, j, Down, j));
+      result.emplace_back(terms);
+    }
+  }
+  return result;
+}
+
+static void BM_SpinCorrelatorsSeparately(benchmark::State& state) {
+  FermionicBasis basis(8, 8);
+  std::vector<CompiledExpression> observables;
+  for (const Expression& observable : spin_correlators(8)) {
+    observables.emplace_back(observable);
+  }
+  ComplexVector x(basis.size(), 1.0);
+  for (auto _ : state) {
+    for (const CompiledExpression& observable : observables) {
+      benchmark::DoNotOptimize(observable.expectation(basis, x));
+    }
+  }
+}
+
+BENCHMARK(BM_SpinCorrelatorsSeparately);
+
+static void BM_SpinCorrelatorsBatched(benchmark::State& state) {
+  FermionicBasis basis(8, 8);
+  ObservableSet observables(spin_correlators(8));
+  ComplexVector x(basis.size(), 1.0);
+  for (auto _ : state) {
+    benchmark::DoNotOptimize(observables.expectation(basis, x));
+  }
+}
+
+BENCHMARK(BM_SpinCorrelatorsBatched);
@@ -129,3 +129,55 @@ static void BM_NormalOrderTermHarder2(benchmark::State& state) {
 }
 
 BENCHMARK(BM_NormalOrderTermHarder2)->RangeMultiplier(2)->Range(8, 64);
+
+// <0| c_{n/2+1} ... c_2 c^dagger_0 ... c^dagger_{n/2-1} |0>, read off the
+// normal ordered expression and evaluated directly.
+static std::vector<Operator> contracted_string(int size) {
+  std::vector<Operator> operators;
+  for (int i = 0; i < size / 2; i++) {
+    operators.push_back(Operator::annihilation<Fermion>(
+        Up, (size / 2 - i + 1) % max_orbital));
+  }
+  for (int i = 0; i < size / 2; i++) {
+    operators.push_back(Operator::creation<Fermion>(Up, i % max_orbital));
+  }
+  return operators;
+}
+
+static void BM_VacuumExpectationByNormalOrdering(benchmark::State& state) {
+  const Term term(1.0, contracted_string(state.range(0)));
+  for (auto _ : state) {
+    const Expression::ExpressionMap terms = NormalOrderer(term).terms();
+    auto it = terms.find({});
+    Term::CoeffType value = it == terms.end() ? 0.0 : it->second;
+    benchmark::DoNotOptimize(value);
+  }
+}
+
+BENCHMARK(BM_VacuumExpectationByNormalOrdering)
+    ->RangeMultiplier(2)
+    ->Range(8, 32);
+
+static void BM_VacuumExpectation(benchmark::State& state) {
+  const Term term(1.0, contracted_string(state.range(0)));
+  for (auto _ : state) {
+    Term::CoeffType value = vacuum_expectation(term);
+    benchmark::DoNotOptimize(value);
+  }
+}
+
+BENCHMARK(BM_VacuumExpectation)->RangeMultiplier(2)->Range(8, 32);
+
+// The string of BM_NormalOrderTermHarder2 up to two-body terms, pruned while
+// being ordered.
+static void BM_NormalOrderTruncated(benchmark::State& state) {
+  const Term term(1.0, contracted_string(state.range(0)));
+  NormalOrderOptions options;
+  options.max_length = 4;
+  for (auto _ : state) {
+    Expression e = NormalOrderer(term, options).expression();
+    benchmark::DoNotOptimize(e);
+  }
+}
+
+BENCHMARK(BM_NormalOrderTruncated)->RangeMultiplier(2)->Range(8, 64);
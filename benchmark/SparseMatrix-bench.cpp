@@ -0,0 +1,92 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include <benchmark/benchmark.h>
+
+#include "DictionaryCsrMatrix.h"
+#include "FermionicBasis.h"
+#include "Models/HubbardSquare.h"
+#include "SellMatrix.h"
+
+// Hamiltonian of a 3x4 Hubbard square lattice.
+static CsrMatrix<std::complex<double>> hubbard_square(std::size_t particles) {
+  HubbardSquare model(1.0, 4.0, 3, 4);
+  FermionicBasis basis(model.size(), particles);
+  return model.matrix(basis);
+}
+
+static void BM_MultiplyCsr(benchmark::State& state) {
+  auto matrix = hubbard_square(static_cast<std::size_t>(state.range(0)));
+  std::vector<std::complex<double>> x(matrix.rows(), 1.0);
+  std::vector<std::complex<double>> y(matrix.rows());
+  for (auto _ : state) {
+    matrix.multiply(x, y);
+    benchmark::DoNotOptimize(y.data());
+  }
+}
+
+BENCHMARK(BM_MultiplyCsr)->DenseRange(6, 8, 2);
+
+static void BM_MultiplyDictionaryCsr(benchmark::State& state) {
+  auto matrix = hubbard_square(static_cast<std::size_t>(state.range(0)));
+  auto compressed =
+      DictionaryCsrMatrix<std::complex<double>, std::uint8_t>::compress(matrix)
+          .value();
+  std::vector<std::complex<double>> x(matrix.rows(), 1.0);
+  std::vector<std::complex<double>> y(matrix.rows());
+  for (auto _ : state) {
+    compressed.multiply(x, y);
+    benchmark::DoNotOptimize(y.data());
+  }
+}
+
+BENCHMARK(BM_MultiplyDictionaryCsr)->DenseRange(6, 8, 2);
+
+// Arguments: particles, kernel (0 = scalar, 1 = AVX2, 2 = AVX-512).
+static void BM_MultiplySell(benchmark::State& state) {
+  const auto kernel = static_cast<SellMatrix::Kernel>(state.range(1));
+  if (kernel > SellMatrix::best_kernel()) {
+    state.SkipWithError("kernel not supported");
+    return;
+  }
+  auto matrix = hubbard_square(static_cast<std::size_t>(state.range(0)));
+  SellMatrix sell(matrix);
+  std::vector<std::complex<double>> x(matrix.rows(), 1.0);
+  std::vector<std::complex<double>> y(matrix.rows());
+  for (auto _ : state) {
+    sell.multiply(x, y, kernel);
+    benchmark::DoNotOptimize(y.data());
+  }
+}
+
+BENCHMARK(BM_MultiplySell)->ArgsProduct({{6, 8}, {0, 1, 2}});
+
+// Arguments: number of vectors k. Products of 8-particle vectors, one at a
+// time and as an interleaved block; both report the time per k vectors.
+static void BM_MultiplyCsrVectors(benchmark::State& state) {
+  const auto k = static_cast<std::size_t>(state.range(0));
+  auto matrix = hubbard_square(8);
+  std::vector<std::complex<double>> x(matrix.rows(), 1.0);
+  std::vector<std::complex<double>> y(matrix.rows());
+  for (auto _ : state) {
+    for (std::size_t j = 0; j < k; j++) {
+      matrix.multiply(x, y);
+      benchmark::DoNotOptimize(y.data());
+    }
+  }
+}
+
+BENCHMARK(BM_MultiplyCsrVectors)->Arg(4)->Arg(8);
+
+static void BM_MultiplyCsrBlock(benchmark::State& state) {
+  const auto k = static_cast<std::size_t>(state.range(0));
+  auto matrix = hubbard_square(8);
+  std::vector<std::complex<double>> x(matrix.rows() * k, 1.0);
+  std::vector<std::complex<double>> y(matrix.rows() * k);
+  for (auto _ : state) {
+    matrix.multiply_block(x, y, k);
+    benchmark::DoNotOptimize(y.data());
+  }
+}
+
+BENCHMARK(BM_MultiplyCsrBlock)->Arg(4)->Arg(8);
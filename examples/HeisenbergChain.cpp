@@ -1,11 +1,13 @@
 // Copyright (c) 2024 Matheus Sousa
 // SPDX-License-Identifier: BSD-2-Clause
 
-#include <armadillo>
+#include <iostream>
 
 #include "Basis.h"
+#include "BlockLanczos.h"
 #include "FermionicBasis.h"
 #include "Model.h"
+#include "StateVector.h"
 
 class HeisenbergChain : public Model {
  public:
@@ -52,54 +54,24 @@ class HeisenbergChain : public Model {
   double m_h;
 };
 
-template <typename Vec>
-std::vector<Term> sorted_terms_from_eigvec(
-    const Basis& basis, const Vec& eigvec) {
-  std::vector<Term> sorted_terms;
-  sorted_terms.reserve(basis.size());
-
-  for (std::size_t i = 0; i < basis.size(); i++) {
-    sorted_terms.emplace_back(eigvec(i), basis.element(i));
-  }
-
-  std::sort(
-      sorted_terms.begin(), sorted_terms.end(),
-      [](const auto& a, const auto& b) {
-        return std::abs(a.coefficient()) > std::abs(b.coefficient());
-      });
-
-  return sorted_terms;
-}
-
 static void analysis(
     const HeisenbergChain& model, const FermionicBasis& basis) {
-  arma::SpMat<std::complex<double>> m(basis.size(), basis.size());
-
-  model.compute_matrix_elements(basis, m);
-
-  arma::cx_vec eigval;
-  arma::cx_mat eigvec;
-  bool ok = arma::eigs_gen(eigval, eigvec, m, 1, "sr");
-
-  if (!ok) {
+  EigenResult result = block_lanczos(LinearOperator(model, basis));
+  if (!result.converged) {
     std::cerr << "Diagonalization failed" << std::endl;
     exit(1);
   }
 
-  const arma::cx_vec& ground_state = eigvec.col(0);
-  std::vector<Term> sorted_terms =
-      sorted_terms_from_eigvec(basis, ground_state);
+  const StateVector ground_state(basis, std::move(result.vectors[0]));
 
   std::cout << "Ground state, energy per site: "
-            << eigval(0) / static_cast<double>(model.size()) << std::endl;
+            << result.values[0] / static_cast<double>(model.size())
+            << std::endl;
 
   const std::size_t states_to_print = 10;
-  for (std::size_t i = 0; i < states_to_print; i++) {
-    std::cout << std::fixed
-              << sorted_terms[i].coefficient() *
-                     std::conj(sorted_terms[i].coefficient())
-              << "  " << basis.state_string(sorted_terms[i].operators())
-              << std::endl;
+  for (const Term& term : ground_state.dominant_terms(states_to_print)) {
+    std::cout << std::fixed << std::norm(term.coefficient()) << "  "
+              << basis.state_string(term.operators()) << std::endl;
   }
 }
 
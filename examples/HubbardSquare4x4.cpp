@@ -9,6 +9,7 @@
 #include "Basis.h"
 #include "FermionicBasis.h"
 #include "Models/HubbardSquare.h"
+#include "SeparableMatrix.h"
 
 // Table 2 of https://journals.aps.org/prb/pdf/10.1103/PhysRevB.45.10741
 constexpr static std::array<double, 4> hubbardModelU = {20, 10, 8, 4};
@@ -36,17 +37,32 @@ int main() {
   std::cout << "Result:   Expected:" << std::endl;
 
   for (std::size_t row = 0; row < rowsToTake; row++) {
+    const double t = 1.0;
+    const std::size_t nx = 4;
+    const std::size_t ny = 4;
+
+    // The hopping and interaction parts are assembled once per basis; every
+    // value of U is then just a scaled sum of the two.
+    FermionicBasis basis(nx * ny, row + 2);
+    SeparableMatrix separable(HubbardSquare(t, 0.0, nx, ny), basis);
+
     for (std::size_t uidx = 0; uidx < hubbardModelU.size(); uidx++) {
-      const double t = 1.0;
       const double u = hubbardModelU[uidx];
-      const std::size_t nx = 4;
-      const std::size_t ny = 4;
-
-      HubbardSquare model(t, u, nx, ny);
-      FermionicBasis basis(model.size(), row + 2);
+      CsrMatrix<std::complex<double>> csr =
+          separable.assemble(HubbardSquare(t, u, nx, ny));
 
-      arma::SpMat<arma::cx_double> mat(basis.size(), basis.size());
-      model.compute_matrix_elements(basis, mat);
+      arma::umat locations(2, csr.nonzeros());
+      arma::cx_vec values(csr.nonzeros());
+      for (std::size_t r = 0; r < csr.rows(); r++) {
+        for (std::size_t k = csr.row_offsets()[r];
+             k < csr.row_offsets()[r + 1]; k++) {
+          locations(0, k) = r;
+          locations(1, k) = csr.columns()[k];
+          values(k) = csr.values()[k];
+        }
+      }
+      arma::SpMat<arma::cx_double> mat(
+          locations, values, basis.size(), basis.size());
       LIBMB_ASSERT(mat.is_hermitian());
 
       arma::cx_vec eigval;
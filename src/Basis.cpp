@@ -18,39 +18,45 @@ void prepare_up_and_down_representation(
   }
 }
 
-void Basis::generate_combinations(
-    BasisElement& current, size_t first_orbital, size_t depth,
-    size_t max_depth) {
-  if (m_basis_filter->filter(current)) {
-    m_basis_map.insert(current);
+void Basis::generate_basis() {
+  // Starting past the last orbital visits only the (empty) root element,
+  // which the filter may or may not accept depending on the basis kind.
+  std::vector<BasisElement> root;
+  BasisElement current;
+  generate_combinations(root, current, m_orbitals, 0, m_particles);
+
+  std::vector<Operator> first = m_particles > 0 ? first_operators()
+                                                 : std::vector<Operator>{};
+  std::vector<std::vector<BasisElement>> subtrees(first.size());
+
+  // The subtrees are independent, so they are expanded concurrently and then
+  // concatenated in the same order as the serial recursion, which keeps the
+  // indices identical regardless of the number of threads.
+#pragma omp parallel for schedule(dynamic)
+  for (std::size_t k = 0; k < first.size(); k++) {
+    BasisElement subtree_current;
+    subtree_current.reserve(m_particles);
+    subtree_current.push_back(first[k]);
+    generate_combinations(
+        subtrees[k], subtree_current, first[k].orbital(), 1, m_particles);
   }
 
-  if (depth == max_depth) {
-    return;
+  std::size_t total = root.size();
+  for (const auto& subtree : subtrees) {
+    total += subtree.size();
   }
+  m_basis_map.reserve(total);
 
-  for (size_t orbital_index = first_orbital; orbital_index < m_orbitals;
-       orbital_index++) {
-    // TODO: bosonic operator should be integer spin
-    auto spin = Operator::Spin::Up;
-    if (current.empty() || current.back().orbital() <= orbital_index) {
-      // In the generic case, we just create a basis with (single-spin) bosons
-      // with all possible particles configurations (0..orbitals)
-      current.push_back(Operator(
-          Operator::Type::Creation, Operator::Statistics::Boson, spin,
-          orbital_index));
-      generate_combinations(current, orbital_index, depth + 1, max_depth);
-      current.pop_back();
+  for (const auto& element : root) {
+    m_basis_map.insert(element);
+  }
+  for (const auto& subtree : subtrees) {
+    for (const auto& element : subtree) {
+      m_basis_map.insert(element);
     }
   }
 }
 
-void Basis::generate_basis() {
-  BasisElement current;
-  current.reserve(m_particles);
-  generate_combinations(current, 0, 0, m_particles);
-}
-
 static constexpr std::string_view unicode_empty_cell = "  ";
 static constexpr std::string_view unicode_up_arrow_cell = "\u2191 ";
 static constexpr std::string_view unicode_down_arrow_cell = " \u2193";
@@ -8,7 +8,7 @@
 #include <vector>
 
 #include "BasisFilter.h"
-#include "IndexedVectorMap.h"
+#include "CompactIndexedVectorMap.h"
 #include "Operator.h"
 #include "Pointers/NonnullOwnPtr.h"
 
@@ -50,6 +50,12 @@ class Basis {
     return m_basis_map.index(term);
   }
 
+  // Index of `term`, or size() if it is not in the basis. Cheaper than a
+  // contains() followed by index().
+  std::size_t find(const BasisElement& term) const {
+    return m_basis_map.find(term);
+  }
+
   std::size_t size() const { return m_basis_map.size(); }
 
   template <typename CompareFunction>
@@ -57,15 +63,32 @@ class Basis {
     m_basis_map.sort(comp);
   }
 
+  // Moves the element at index order[k] to index k, for every k. Used for
+  // orderings that are computed as a whole (e.g. bandwidth reductions) rather
+  // than from pairwise comparisons.
+  void reorder(const std::vector<std::size_t>& order) {
+    m_basis_map.permute(order);
+  }
+
   std::string state_string(const BasisElement& element) const;
 
  protected:
   void generate_basis();
-  virtual void generate_combinations(BasisElement&, size_t, size_t, size_t) = 0;
+
+  // Depth-first enumeration of the basis elements below `current`, appending
+  // the ones accepted by the filter to the output in canonical order.
+  virtual void generate_combinations(
+      std::vector<BasisElement>&, BasisElement&, size_t, size_t,
+      size_t) const = 0;
+
+  // Operators that can open a basis element, in the order in which
+  // generate_combinations visits them. Each one roots an independent subtree
+  // of the enumeration.
+  virtual std::vector<Operator> first_operators() const = 0;
 
   std::size_t m_orbitals;
   std::size_t m_particles;
-  IndexedVectorMap<BasisElement> m_basis_map;
+  CompactIndexedVectorMap<BasisElement> m_basis_map;
   NonnullOwnPtr<BasisFilter> m_basis_filter;
 };
 
@@ -0,0 +1,95 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "BasisOrdering.h"
+
+#include <algorithm>
+
+#include "Assert.h"
+
+// Breadth-first search from `root` over the unvisited vertices, visiting the
+// neighbours of each vertex by increasing degree. Appends the visited vertices
+// to `order` and returns the first vertex of the last level.
+static std::size_t cuthill_mckee_from(
+    const BasisGraph& graph, std::size_t root, std::vector<bool>& visited,
+    std::vector<std::size_t>& order) {
+  std::size_t level_begin = order.size();
+  std::size_t last_level = root;
+  std::vector<std::size_t> neighbours;
+
+  order.push_back(root);
+  visited[root] = true;
+  for (std::size_t head = level_begin; head < order.size(); head++) {
+    if (head == level_begin) {
+      last_level = order[head];
+      level_begin = order.size();
+    }
+    neighbours.clear();
+    for (std::size_t v : graph[order[head]]) {
+      if (!visited[v]) {
+        visited[v] = true;
+        neighbours.push_back(v);
+      }
+    }
+    std::stable_sort(
+        neighbours.begin(), neighbours.end(),
+        [&](std::size_t a, std::size_t b) {
+          return graph[a].size() < graph[b].size();
+        });
+    order.insert(order.end(), neighbours.begin(), neighbours.end());
+  }
+  return last_level;
+}
+
+std::vector<std::size_t> reverse_cuthill_mckee(const BasisGraph& graph) {
+  const std::size_t size = graph.size();
+  std::vector<std::size_t> by_degree(size);
+  for (std::size_t v = 0; v < size; v++) {
+    by_degree[v] = v;
+  }
+  std::stable_sort(
+      by_degree.begin(), by_degree.end(), [&](std::size_t a, std::size_t b) {
+        return graph[a].size() < graph[b].size();
+      });
+
+  std::vector<bool> visited(size, false);
+  std::vector<std::size_t> order;
+  order.reserve(size);
+
+  for (std::size_t start : by_degree) {
+    if (visited[start]) {
+      continue;
+    }
+
+    // A vertex in the last level of a search from a minimum-degree vertex is
+    // a cheap approximation of a peripheral vertex, which gives narrower
+    // level structures.
+    std::size_t component_begin = order.size();
+    std::size_t root = cuthill_mckee_from(graph, start, visited, order);
+    for (std::size_t k = component_begin; k < order.size(); k++) {
+      visited[order[k]] = false;
+    }
+    order.resize(component_begin);
+    cuthill_mckee_from(graph, root, visited, order);
+  }
+
+  LIBMB_ASSERT(order.size() == size);
+  std::reverse(order.begin(), order.end());
+  return order;
+}
+
+std::size_t bandwidth(
+    const BasisGraph& graph, const std::vector<std::size_t>& position) {
+  auto label = [&](std::size_t v) {
+    return position.empty() ? v : position[v];
+  };
+  std::size_t result = 0;
+  for (std::size_t v = 0; v < graph.size(); v++) {
+    for (std::size_t w : graph[v]) {
+      std::size_t a = label(v);
+      std::size_t b = label(w);
+      result = std::max(result, a > b ? a - b : b - a);
+    }
+  }
+  return result;
+}
@@ -0,0 +1,66 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <vector>
+
+#include "Basis.h"
+#include "SparseMatrix.h"
+
+// Adjacency lists of the graph whose vertices are basis states and whose
+// edges are the nonzero off-diagonal matrix elements between them.
+using BasisGraph = std::vector<std::vector<std::size_t>>;
+
+struct BandwidthReport {
+  std::size_t before;
+  std::size_t after;
+};
+
+// Reverse Cuthill-McKee ordering of the graph. The k-th entry of the result is
+// the vertex that should be placed at position k.
+std::vector<std::size_t> reverse_cuthill_mckee(const BasisGraph& graph);
+
+// Largest |i - j| over the edges of the graph, after relabeling every vertex
+// v as position[v]. With an empty `position` the vertices keep their labels.
+std::size_t bandwidth(
+    const BasisGraph& graph, const std::vector<std::size_t>& position = {});
+
+template <typename T>
+BasisGraph basis_graph(const SparseMatrix<T>& matrix, std::size_t size) {
+  BasisGraph graph(size);
+  for (const auto& [index, value] : matrix.elements()) {
+    if (index.i != index.j) {
+      graph[index.i].push_back(index.j);
+      graph[index.j].push_back(index.i);
+    }
+  }
+  for (auto& neighbours : graph) {
+    std::sort(neighbours.begin(), neighbours.end());
+    neighbours.erase(
+        std::unique(neighbours.begin(), neighbours.end()), neighbours.end());
+  }
+  return graph;
+}
+
+// Reorders the basis with Reverse Cuthill-McKee on the graph of `matrix`,
+// which must have been computed in this basis, so that states connected by
+// the Hamiltonian get nearby indices. The matrix has to be recomputed after
+// the reordering; its bandwidth will be the reported `after` value.
+template <typename T>
+BandwidthReport reorder_reverse_cuthill_mckee(
+    Basis& basis, const SparseMatrix<T>& matrix) {
+  BasisGraph graph = basis_graph(matrix, basis.size());
+  std::vector<std::size_t> order = reverse_cuthill_mckee(graph);
+
+  std::vector<std::size_t> position(order.size());
+  for (std::size_t k = 0; k < order.size(); k++) {
+    position[order[k]] = k;
+  }
+
+  BandwidthReport report{bandwidth(graph), bandwidth(graph, position)};
+  basis.reorder(order);
+  return report;
+}
@@ -0,0 +1,88 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "BasisRange.h"
+
+BasisRange::Iterator::Iterator(const BasisRange* range) : m_range(range) {
+  m_slots.resize(range->m_particles);
+  m_element.reserve(range->m_particles);
+  if (!first_combination()) {
+    m_range = nullptr;
+    return;
+  }
+  skip_rejected();
+}
+
+BasisRange::Iterator& BasisRange::Iterator::operator++() {
+  if (!next_combination()) {
+    m_range = nullptr;
+    return *this;
+  }
+  skip_rejected();
+  return *this;
+}
+
+void BasisRange::Iterator::skip_rejected() {
+  while (!m_range->m_basis_filter->filter(m_element)) {
+    if (!next_combination()) {
+      m_range = nullptr;
+      return;
+    }
+  }
+}
+
+bool BasisRange::Iterator::first_combination() {
+  const std::size_t slots = m_range->slots();
+  for (std::size_t k = 0; k < m_slots.size(); k++) {
+    m_slots[k] = k == 0 ? 0 : m_range->next_slot(m_slots[k - 1]);
+    if (m_slots[k] >= slots) {
+      return false;
+    }
+  }
+  m_element.clear();
+  for (std::size_t slot : m_slots) {
+    m_element.push_back(m_range->slot_operator(slot));
+  }
+  return true;
+}
+
+bool BasisRange::Iterator::next_combination() {
+  const std::size_t slots = m_range->slots();
+  const std::size_t size = m_slots.size();
+
+  // Find the rightmost slot that can be incremented while leaving room for the
+  // smallest possible continuation after it.
+  for (std::size_t k = size; k-- > 0;) {
+    std::size_t slot = m_slots[k] + 1;
+    std::size_t last = slot;
+    for (std::size_t j = k + 1; j < size && last < slots; j++) {
+      last = m_range->next_slot(last);
+    }
+    if (last >= slots) {
+      continue;
+    }
+
+    for (std::size_t j = k; j < size; j++) {
+      m_slots[j] = j == k ? slot : m_range->next_slot(m_slots[j - 1]);
+      m_element[j] = m_range->slot_operator(m_slots[j]);
+    }
+    return true;
+  }
+  return false;
+}
+
+std::size_t FermionicBasisRange::next_slot(std::size_t slot) const {
+  return m_allow_double_occupancy ? slot + 1 : 2 * (slot / 2 + 1);
+}
+
+Operator FermionicBasisRange::slot_operator(std::size_t slot) const {
+  return Operator(
+      Operator::Type::Creation, Operator::Statistics::Fermion,
+      static_cast<Operator::Spin>(slot % 2), slot / 2);
+}
+
+Operator BosonicBasisRange::slot_operator(std::size_t slot) const {
+  return Operator(
+      Operator::Type::Creation, Operator::Statistics::Boson,
+      Operator::Spin::Up, slot);
+}
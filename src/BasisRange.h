@@ -0,0 +1,132 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+#include "BasisFilter.h"
+#include "Operator.h"
+#include "Pointers/NonnullOwnPtr.h"
+
+// A lazy view over the elements of a basis. The elements are produced one at
+// a time in the same canonical order (and therefore with the same indices) as
+// the corresponding Basis, but only O(particles) state is kept, so passes
+// that visit each state once do not need to materialize the basis.
+//
+// Internally a basis element is a non-decreasing sequence of "slots", where
+// each slot corresponds to a single creation operator.
+class BasisRange {
+ public:
+  class Iterator {
+   public:
+    using value_type = BasisElement;
+    using difference_type = std::ptrdiff_t;
+
+    Iterator() = default;
+
+    const BasisElement& operator*() const { return m_element; }
+
+    const BasisElement* operator->() const { return &m_element; }
+
+    Iterator& operator++();
+
+    void operator++(int) { ++*this; }
+
+    bool operator==(std::default_sentinel_t) const {
+      return m_range == nullptr;
+    }
+
+   private:
+    friend class BasisRange;
+
+    explicit Iterator(const BasisRange* range);
+
+    bool first_combination();
+
+    bool next_combination();
+
+    void skip_rejected();
+
+    const BasisRange* m_range = nullptr;
+    std::vector<std::size_t> m_slots;
+    BasisElement m_element;
+  };
+
+  virtual ~BasisRange() = default;
+
+  BasisRange(const BasisRange&) = delete;
+  BasisRange& operator=(const BasisRange&) = delete;
+
+  Iterator begin() const { return Iterator(this); }
+
+  std::default_sentinel_t end() const { return std::default_sentinel; }
+
+  std::size_t orbitals() const { return m_orbitals; }
+
+  std::size_t particles() const { return m_particles; }
+
+ protected:
+  BasisRange(std::size_t n, std::size_t m)
+      : m_orbitals{n}, m_particles{m}, m_basis_filter{make<BasisFilter>()} {}
+
+  BasisRange(std::size_t n, std::size_t m, BasisFilter* filter)
+      : m_orbitals{n}, m_particles{m}, m_basis_filter{adopt_own(filter)} {}
+
+  // Number of distinct slots.
+  virtual std::size_t slots() const = 0;
+
+  // Smallest slot that may follow `slot` in a basis element.
+  virtual std::size_t next_slot(std::size_t slot) const = 0;
+
+  // Creation operator associated with `slot`.
+  virtual Operator slot_operator(std::size_t slot) const = 0;
+
+  std::size_t m_orbitals;
+  std::size_t m_particles;
+  NonnullOwnPtr<BasisFilter> m_basis_filter;
+};
+
+class FermionicBasisRange final : public BasisRange {
+ public:
+  FermionicBasisRange(
+      std::size_t n, std::size_t m, BasisFilter* filter,
+      bool allow_double_occupancy)
+      : BasisRange(n, m, filter),
+        m_allow_double_occupancy{allow_double_occupancy} {}
+
+  FermionicBasisRange(std::size_t n, std::size_t m, bool allow_double_occupancy)
+      : BasisRange(n, m), m_allow_double_occupancy{allow_double_occupancy} {}
+
+  FermionicBasisRange(std::size_t n, std::size_t m, BasisFilter* filter)
+      : BasisRange(n, m, filter), m_allow_double_occupancy{true} {}
+
+  FermionicBasisRange(std::size_t n, std::size_t m)
+      : BasisRange(n, m), m_allow_double_occupancy{true} {}
+
+ private:
+  std::size_t slots() const override { return 2 * m_orbitals; }
+
+  std::size_t next_slot(std::size_t slot) const override;
+
+  Operator slot_operator(std::size_t slot) const override;
+
+  bool m_allow_double_occupancy;
+};
+
+class BosonicBasisRange final : public BasisRange {
+ public:
+  BosonicBasisRange(std::size_t n, std::size_t m) : BasisRange(n, m) {}
+
+  BosonicBasisRange(std::size_t n, std::size_t m, BasisFilter* filter)
+      : BasisRange(n, m, filter) {}
+
+ private:
+  std::size_t slots() const override { return m_orbitals; }
+
+  std::size_t next_slot(std::size_t slot) const override { return slot; }
+
+  Operator slot_operator(std::size_t slot) const override;
+};
@@ -0,0 +1,143 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "BlockLanczos.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "Assert.h"
+
+EigenResult block_lanczos(
+    const LinearOperator& op, const BlockLanczosOptions& options) {
+  const std::size_t n = op.size();
+  const std::size_t roots = options.roots;
+  const std::size_t k = options.block_size == 0 ? roots : options.block_size;
+  const std::size_t max_basis = std::min(
+      n, options.max_basis == 0 ? std::max<std::size_t>(40, 10 * k)
+                                : options.max_basis);
+  LIBMB_ASSERT(roots > 0 && k >= roots && k <= n);
+  LIBMB_ASSERT(max_basis >= std::min(n, 2 * k));
+
+  std::mt19937_64 rng(options.seed);
+  std::vector<ComplexVector> blocks;
+  ComplexVector start = random_vector(n * k, rng);
+  orthonormalize(start, k, blocks, k, rng);
+  blocks.push_back(std::move(start));
+
+  // Projection of the operator on the basis, T = V^H A V, with leading
+  // dimension max_basis.
+  ComplexVector t(max_basis * max_basis);
+  auto at = [&](std::size_t i, std::size_t j) -> Complex& {
+    return t[i + j * max_basis];
+  };
+
+  // Combination of the basis blocks with the coefficients in rows of
+  // `vectors`, for the first `count` columns.
+  auto combine = [&](const ComplexVector& vectors, std::size_t dim,
+                     std::size_t count) {
+    ComplexVector result(n * count);
+    for (std::size_t b = 0; b < blocks.size(); b++) {
+      ComplexVector c(k * count);
+      for (std::size_t j = 0; j < count; j++) {
+        for (std::size_t a = 0; a < k; a++) {
+          c[a + j * k] = vectors[b * k + a + j * dim];
+        }
+      }
+      axpy(1.0, block_multiply(blocks[b], k, c, count), result);
+    }
+    return result;
+  };
+
+  EigenResult result;
+  while (true) {
+    const std::size_t j = blocks.size() - 1;
+    const std::size_t dim = (j + 1) * k;
+    ComplexVector w;
+    op.apply_block(blocks[j], w, k);
+    result.applications += k;
+
+    // Full reorthogonalisation, done twice; the coefficients are column
+    // block j of T.
+    for (std::size_t pass = 0; pass < 2; pass++) {
+      for (std::size_t i = 0; i <= j; i++) {
+        const ComplexVector c = block_inner(blocks[i], k, w, k);
+        block_subtract(w, k, blocks[i], k, c);
+        for (std::size_t b = 0; b < k; b++) {
+          for (std::size_t a = 0; a < k; a++) {
+            at(i * k + a, j * k + b) += c[a + b * k];
+          }
+        }
+      }
+    }
+    for (std::size_t col = j * k; col < dim; col++) {
+      for (std::size_t row = 0; row < col; row++) {
+        at(col, row) = std::conj(at(row, col));
+      }
+      at(col, col) = at(col, col).real();
+    }
+
+    // Rayleigh-Ritz on the current basis. The residual of a Ritz pair is W
+    // times the last block of its coefficients.
+    ComplexVector projection(dim * dim);
+    for (std::size_t col = 0; col < dim; col++) {
+      for (std::size_t row = 0; row < dim; row++) {
+        projection[row + col * dim] = at(row, col);
+      }
+    }
+    const HermitianEigen ritz = hermitian_eigen(std::move(projection), dim);
+    ComplexVector last(k * roots);
+    for (std::size_t i = 0; i < roots; i++) {
+      for (std::size_t a = 0; a < k; a++) {
+        last[a + i * k] = ritz.vectors[j * k + a + i * dim];
+      }
+    }
+    const ComplexVector residual = block_multiply(w, k, last, roots);
+    const ComplexVector residual_norms =
+        block_inner(residual, roots, residual, roots);
+    result.converged = true;
+    result.residuals.assign(roots, 0.0);
+    for (std::size_t i = 0; i < roots; i++) {
+      result.residuals[i] = std::sqrt(residual_norms[i + i * roots].real());
+      if (result.residuals[i] >
+          options.tolerance * std::max(1.0, std::abs(ritz.values[i]))) {
+        result.converged = false;
+      }
+    }
+
+    // A failed Rayleigh-Ritz step ends the run, unconverged.
+    result.converged = result.converged && ritz.converged;
+    const bool can_grow = dim + k <= n;
+    const bool restart = dim + k > max_basis;
+    if (result.converged || !ritz.converged || !can_grow ||
+        (restart && result.restarts == options.max_restarts)) {
+      const ComplexVector x = combine(ritz.vectors, dim, roots);
+      result.values.assign(
+          ritz.values.begin(),
+          ritz.values.begin() + static_cast<std::ptrdiff_t>(roots));
+      for (std::size_t i = 0; i < roots; i++) {
+        result.vectors.push_back(block_column(x, roots, i));
+      }
+      return result;
+    }
+
+    orthonormalize(w, k, blocks, k, rng);
+    if (restart) {
+      // Thick restart: keep the k lowest Ritz vectors, on which T is
+      // diagonal, followed by the residual block. Their coupling is
+      // recomputed when the operator is applied to the residual block.
+      ComplexVector x = combine(ritz.vectors, dim, k);
+      blocks.clear();
+      blocks.push_back(std::move(x));
+      std::fill(t.begin(), t.end(), Complex{});
+      for (std::size_t a = 0; a < k; a++) {
+        at(a, a) = ritz.values[a];
+      }
+      result.restarts++;
+    }
+    blocks.push_back(std::move(w));
+  }
+}
@@ -0,0 +1,35 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "LinearOperator.h"
+
+struct BlockLanczosOptions {
+  // Number of lowest eigenpairs wanted.
+  std::size_t roots = 1;
+  // Number of vectors per block, at least `roots`; zero means `roots`. A
+  // block as wide as the degeneracy of the wanted eigenvalues resolves it.
+  std::size_t block_size = 0;
+  // Dimension of the Krylov space at which the iteration is restarted; zero
+  // means max(40, 10 * block size).
+  std::size_t max_basis = 0;
+  std::size_t max_restarts = 100;
+  // A pair converges when ||A x - lambda x|| <= tolerance * max(1, |lambda|).
+  double tolerance = 1e-9;
+  // Seed of the random starting block.
+  std::uint64_t seed = 0;
+};
+
+// Lowest eigenpairs of the Hermitian operator `op` by block Lanczos. Every
+// step applies the operator to a block of vectors at once, so a memory-bound
+// matrix is streamed once per block instead of once per vector.
+//
+// The Krylov basis is kept fully reorthogonalised, and once it reaches
+// `max_basis` the iteration is thick-restarted from the current block of
+// Ritz vectors and the last residual block.
+EigenResult block_lanczos(
+    const LinearOperator& op, const BlockLanczosOptions& options = {});
@@ -4,10 +4,12 @@
 #include "BosonicBasis.h"
 
 void BosonicBasis::generate_combinations(
-    BasisElement& current, size_t first_orbital, size_t depth,
-    size_t max_depth) {
-  if (depth == max_depth && m_basis_filter->filter(current)) {
-    m_basis_map.insert(current);
+    std::vector<BasisElement>& out, BasisElement& current, size_t first_orbital,
+    size_t depth, size_t max_depth) const {
+  if (depth == max_depth) {
+    if (m_basis_filter->filter(current)) {
+      out.push_back(current);
+    }
     return;
   }
 
@@ -19,8 +21,20 @@ void BosonicBasis::generate_combinations(
       current.push_back(Operator(
           Operator::Type::Creation, Operator::Statistics::Boson, spin,
           orbital_index));
-      generate_combinations(current, orbital_index, depth + 1, max_depth);
+      generate_combinations(
+          out, current, orbital_index, depth + 1, max_depth);
       current.pop_back();
     }
   }
 }
+
+std::vector<Operator> BosonicBasis::first_operators() const {
+  std::vector<Operator> result;
+  result.reserve(m_orbitals);
+  for (size_t orbital_index = 0; orbital_index < m_orbitals; orbital_index++) {
+    result.push_back(Operator(
+        Operator::Type::Creation, Operator::Statistics::Boson,
+        Operator::Spin::Up, orbital_index));
+  }
+  return result;
+}
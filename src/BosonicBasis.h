@@ -14,5 +14,9 @@ class BosonicBasis final : public Basis {
     generate_basis();
   }
 
-  void generate_combinations(BasisElement &, size_t, size_t, size_t) override;
+  void generate_combinations(
+      std::vector<BasisElement> &, BasisElement &, size_t, size_t,
+      size_t) const override;
+
+  std::vector<Operator> first_operators() const override;
 };
@@ -0,0 +1,163 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "Assert.h"
+#include "ParallelSort.h"
+
+// Same interface as IndexedVectorMap, but every element is stored only once.
+// The lookup table is an open-addressing hash table (linear probing) whose
+// slots hold indices into the element vector; hashing and comparisons go
+// through the referenced element. Each element therefore costs a couple of
+// `Index` slots on top of its own storage instead of a full key copy plus a
+// hash map node.
+template <class T, class Index = std::uint32_t>
+class CompactIndexedVectorMap {
+ public:
+  using element_type = T;
+  using index_type = Index;
+
+ private:
+  static constexpr Index empty_slot = std::numeric_limits<Index>::max();
+  static constexpr std::size_t min_capacity = 16;
+
+  std::vector<T> m_elements;
+  std::vector<Index> m_slots;
+
+ public:
+  const std::vector<T>& elements() const { return m_elements; }
+
+  void insert(const T& value) {
+    // We don't check if the element is already in the map
+    LIBMB_ASSERT(m_elements.size() < empty_slot);
+    if (2 * (m_elements.size() + 1) > m_slots.size()) {
+      rehash(std::max(min_capacity, 2 * m_slots.size()));
+    }
+    m_elements.push_back(value);
+    place(m_elements.size() - 1);
+  }
+
+  void reserve(std::size_t n) {
+    m_elements.reserve(n);
+    if (2 * n > m_slots.size()) {
+      rehash(std::bit_ceil(std::max(min_capacity, 2 * n)));
+    }
+  }
+
+  const T& operator[](std::size_t idx) const { return m_elements[idx]; }
+
+  std::size_t index(const T& value) const {
+    std::size_t idx = find(value);
+    if (idx == m_elements.size()) {
+      throw std::out_of_range("CompactIndexedVectorMap::index");
+    }
+    return idx;
+  }
+
+  bool contains(const T& value) const {
+    return find(value) != m_elements.size();
+  }
+
+  // Returns the index of `value`, or size() if it is not in the map.
+  std::size_t find(const T& value) const {
+    if (m_slots.empty()) {
+      return m_elements.size();
+    }
+    const std::size_t mask = m_slots.size() - 1;
+    for (std::size_t slot = home_slot(value);; slot = (slot + 1) & mask) {
+      Index idx = m_slots[slot];
+      if (idx == empty_slot) {
+        return m_elements.size();
+      }
+      if (m_elements[idx] == value) {
+        return idx;
+      }
+    }
+  }
+
+  std::size_t size() const { return m_elements.size(); }
+
+  template <class CompareFunction>
+  void sort(CompareFunction comp) {
+    parallel_sort(m_elements.begin(), m_elements.end(), comp);
+    rebuild();
+  }
+
+  // Rearranges the elements so that the k-th one is the element previously at
+  // index order[k].
+  void permute(const std::vector<std::size_t>& order) {
+    LIBMB_ASSERT(order.size() == m_elements.size());
+    const std::size_t size = m_elements.size();
+    std::vector<T> permuted(size);
+#pragma omp parallel for schedule(static)
+    for (std::size_t k = 0; k < size; k++) {
+      permuted[k] = std::move(m_elements[order[k]]);
+    }
+    m_elements = std::move(permuted);
+    rebuild();
+  }
+
+ private:
+  std::size_t home_slot(const T& value) const {
+    // Fibonacci hashing: the top bits of the product depend on all the bits of
+    // the (possibly weak) hash, and the table size is a power of two.
+    constexpr int digits = std::numeric_limits<std::size_t>::digits;
+    std::size_t h = std::hash<T>{}(value) * std::size_t{0x9e3779b97f4a7c15};
+    return h >> (digits - std::countr_zero(m_slots.size()));
+  }
+
+  void place(std::size_t idx) {
+    const std::size_t mask = m_slots.size() - 1;
+    std::size_t slot = home_slot(m_elements[idx]);
+    while (m_slots[slot] != empty_slot) {
+      slot = (slot + 1) & mask;
+    }
+    m_slots[slot] = static_cast<Index>(idx);
+  }
+
+  // Refills the table after the elements were permuted. The elements are
+  // distinct, so they can be placed concurrently: each thread claims the first
+  // free slot along its probe sequence with a compare-and-swap.
+  void rebuild() {
+    const std::size_t mask = m_slots.size() - 1;
+    const std::size_t capacity = m_slots.size();
+#pragma omp parallel for schedule(static)
+    for (std::size_t slot = 0; slot < capacity; slot++) {
+      m_slots[slot] = empty_slot;
+    }
+
+    const std::size_t size = m_elements.size();
+#pragma omp parallel for schedule(static)
+    for (std::size_t idx = 0; idx < size; idx++) {
+      for (std::size_t slot = home_slot(m_elements[idx]);;
+           slot = (slot + 1) & mask) {
+        std::atomic_ref<Index> entry(m_slots[slot]);
+        Index expected = empty_slot;
+        if (entry.load(std::memory_order_relaxed) == empty_slot &&
+            entry.compare_exchange_strong(
+                expected, static_cast<Index>(idx), std::memory_order_relaxed)) {
+          break;
+        }
+      }
+    }
+  }
+
+  void rehash(std::size_t capacity) {
+    m_slots.assign(capacity, empty_slot);
+    for (std::size_t idx = 0; idx < m_elements.size(); idx++) {
+      place(idx);
+    }
+  }
+};
@@ -0,0 +1,491 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "CompiledExpression.h"
+
+#include <omp.h>
+
+#include <algorithm>
+#include <bit>
+#include <span>
+
+#include "Assert.h"
+#include "FermionicState.h"
+#include "NormalOrder.h"
+
+CompiledExpression::CompiledExpression(const std::vector<Term>& terms) {
+  compile(Expression(terms));
+}
+
+CompiledExpression::CompiledExpression(const Expression& expression) {
+  compile(expression);
+}
+
+void CompiledExpression::compile(const Expression& expression) {
+  const Expression::ExpressionMap terms = NormalOrderer(expression).terms();
+  for (const auto& [operators, coefficient] : terms) {
+    if (coefficient == CoeffType{}) {
+      continue;
+    }
+    Term term(coefficient, operators);
+    m_adjoint_terms.push_back(term.adjoint());
+
+    if (!std::all_of(operators.begin(), operators.end(), [](const auto& op) {
+          return op.is_fermion();
+        })) {
+      m_generic.push_back(term);
+      m_generic_adjoint_terms.push_back(term.adjoint());
+      continue;
+    }
+
+    // Normal ordered: all the creation operators come first.
+    std::vector<std::uint8_t> created;
+    std::vector<std::uint8_t> annihilated;
+    std::uint64_t created_mask = 0;
+    std::uint64_t annihilated_mask = 0;
+    for (const Operator& op : operators) {
+      LIBMB_ASSERT(op.orbital() < 32);
+      if (op.type() == Operator::Type::Creation) {
+        created.push_back(fermion_slot(op));
+        created_mask |= slot_bit(fermion_slot(op));
+      } else {
+        annihilated.push_back(fermion_slot(op));
+        annihilated_mask |= slot_bit(fermion_slot(op));
+      }
+    }
+
+    if (created_mask == annihilated_mask &&
+        created.size() == annihilated.size() &&
+        static_cast<std::size_t>(std::popcount(created_mask)) ==
+            created.size()) {
+      // c^dagger_1 ... c^dagger_k c_k ... c_1 = n_1 ... n_k
+      m_diagonal.push_back({created_mask, coefficient});
+    } else if (created.size() == 1 && annihilated.size() == 1) {
+      m_hopping.push_back({created[0], annihilated[0], coefficient});
+    } else if (created.size() == 2 && annihilated.size() == 2) {
+      m_two_body.push_back(
+          {{created[0], created[1], annihilated[0], annihilated[1]},
+           coefficient});
+    } else {
+      m_fermionic.push_back(term);
+    }
+  }
+  group_diagonal_terms();
+  split_hermitian_pairs(terms);
+}
+
+void CompiledExpression::split_hermitian_pairs(
+    const Expression::ExpressionMap& terms) {
+  // The operator is Hermitian if normal ordering its adjoint gives back the
+  // same terms.
+  const Expression::ExpressionMap adjoint =
+      NormalOrderer(m_adjoint_terms).terms();
+  auto matches = [](const Expression::ExpressionMap& map,
+                    const std::vector<Operator>& operators, CoeffType value) {
+    auto it = map.find(operators);
+    CoeffType other = it == map.end() ? CoeffType{} : it->second;
+    return std::abs(other - value) <= 1e-12 * std::max(1.0, std::abs(value));
+  };
+  for (const auto& [operators, coefficient] : terms) {
+    if (!matches(adjoint, operators, coefficient)) {
+      return;
+    }
+  }
+  for (const auto& [operators, coefficient] : adjoint) {
+    if (!matches(terms, operators, coefficient)) {
+      return;
+    }
+  }
+  m_hermitian = true;
+
+  // T^dagger annihilates the slots T creates and vice versa, so keeping the
+  // terms whose creation mask is the smaller keeps exactly one of each pair.
+  auto slots_mask = [](auto first, auto last) {
+    std::uint64_t mask = 0;
+    for (; first != last; ++first) {
+      mask |= slot_bit(*first);
+    }
+    return mask;
+  };
+  m_half_hopping = static_cast<std::size_t>(
+      std::stable_partition(
+          m_hopping.begin(), m_hopping.end(),
+          [](const HoppingTerm& term) { return term.to < term.from; }) -
+      m_hopping.begin());
+  m_half_two_body = static_cast<std::size_t>(
+      std::stable_partition(
+          m_two_body.begin(), m_two_body.end(),
+          [&](const TwoBodyTerm& term) {
+            return slots_mask(term.slots.begin(), term.slots.begin() + 2) <
+                   slots_mask(term.slots.begin() + 2, term.slots.end());
+          }) -
+      m_two_body.begin());
+  m_half_fermionic = static_cast<std::size_t>(
+      std::stable_partition(
+          m_fermionic.begin(), m_fermionic.end(),
+          [](const Term& term) {
+            std::uint64_t created = 0;
+            std::uint64_t annihilated = 0;
+            for (const Operator& op : term.operators()) {
+              (op.type() == Operator::Type::Creation ? created : annihilated) |=
+                  slot_bit(fermion_slot(op));
+            }
+            return created < annihilated;
+          }) -
+      m_fermionic.begin());
+}
+
+void CompiledExpression::group_diagonal_terms() {
+  for (const auto& [mask, coefficient] : m_diagonal) {
+    switch (std::popcount(mask)) {
+      case 0:
+        m_constant += coefficient;
+        break;
+      case 1: {
+        auto it = std::find_if(
+            m_densities.begin(), m_densities.end(),
+            [&](const DensityGroup& group) {
+              return group.coefficient == coefficient;
+            });
+        if (it == m_densities.end()) {
+          m_densities.push_back({mask, coefficient});
+        } else {
+          it->mask |= mask;
+        }
+        break;
+      }
+      case 2: {
+        const auto low = static_cast<std::size_t>(std::countr_zero(mask));
+        const auto shift =
+            static_cast<std::size_t>(std::countr_zero(mask & (mask - 1))) -
+            low;
+        auto it = std::find_if(
+            m_pairs.begin(), m_pairs.end(), [&](const PairGroup& group) {
+              return group.shift == shift && group.coefficient == coefficient;
+            });
+        if (it == m_pairs.end()) {
+          m_pairs.push_back({slot_bit(low), shift, coefficient});
+        } else {
+          it->mask |= slot_bit(low);
+        }
+        break;
+      }
+      default:
+        m_higher_diagonal.push_back({mask, coefficient});
+    }
+  }
+}
+
+CompiledExpression::CoeffType CompiledExpression::diagonal_value(
+    std::uint64_t occupation) const {
+  CoeffType result = m_constant;
+  for (const auto& [mask, coefficient] : m_densities) {
+    result +=
+        coefficient * static_cast<double>(std::popcount(occupation & mask));
+  }
+  for (const auto& [mask, shift, coefficient] : m_pairs) {
+    result += coefficient * static_cast<double>(std::popcount(
+                                occupation & (occupation >> shift) & mask));
+  }
+  for (const auto& [mask, coefficient] : m_higher_diagonal) {
+    if ((occupation & mask) == mask) {
+      result += coefficient;
+    }
+  }
+  return result;
+}
+
+CompiledExpression::CoeffType CompiledExpression::diagonal(
+    const Basis& basis, std::size_t row, Workspace& workspace) const {
+  const BasisElement& state = basis.elements()[row];
+  if (is_fermionic_state(state) && m_generic.empty()) {
+    return diagonal_value(occupation_mask(state));
+  }
+  this->row(basis, row, basis, workspace);
+  auto it = std::lower_bound(
+      workspace.entries.begin(), workspace.entries.end(), row,
+      [](const Entry& entry, std::size_t column) {
+        return entry.column < column;
+      });
+  return it != workspace.entries.end() && it->column == row ? it->value
+                                                            : CoeffType{};
+}
+
+std::vector<CompiledExpression::CoeffType> CompiledExpression::diagonal(
+    const Basis& basis) const {
+  const std::size_t size = basis.size();
+  std::vector<CoeffType> result(size);
+#pragma omp parallel
+  {
+    Workspace workspace;
+#pragma omp for schedule(dynamic, 256)
+    for (std::size_t r = 0; r < size; r++) {
+      result[r] = diagonal(basis, r, workspace);
+    }
+  }
+  return result;
+}
+
+CsrMatrix<CompiledExpression::CoeffType> CompiledExpression::matrix(
+    const Basis& basis) const {
+  const std::size_t size = basis.size();
+  const auto threads = static_cast<std::size_t>(omp_get_max_threads());
+  std::vector<std::size_t> offsets(size + 1, 0);
+  std::vector<std::vector<Entry>> chunks(threads);
+  std::vector<std::size_t> first_rows(threads, size);
+
+  // With a static schedule every thread gets one contiguous block of rows, so
+  // its entries can later be copied to the right place in one piece.
+#pragma omp parallel
+  {
+    const auto thread = static_cast<std::size_t>(omp_get_thread_num());
+    Workspace workspace;
+#pragma omp for schedule(static)
+    for (std::size_t r = 0; r < size; r++) {
+      row(basis, r, basis, workspace);
+      first_rows[thread] = std::min(first_rows[thread], r);
+      offsets[r + 1] = workspace.entries.size();
+      chunks[thread].insert(
+          chunks[thread].end(), workspace.entries.begin(),
+          workspace.entries.end());
+    }
+  }
+
+  for (std::size_t r = 0; r < size; r++) {
+    offsets[r + 1] += offsets[r];
+  }
+
+  std::vector<std::size_t> columns(offsets[size]);
+  std::vector<CoeffType> values(offsets[size]);
+#pragma omp parallel for schedule(static, 1)
+  for (std::size_t thread = 0; thread < threads; thread++) {
+    if (first_rows[thread] == size) {
+      continue;
+    }
+    std::size_t k = offsets[first_rows[thread]];
+    for (const auto& [column, value] : chunks[thread]) {
+      columns[k] = column;
+      values[k] = value;
+      k++;
+    }
+  }
+  return CsrMatrix<CoeffType>(
+      size, std::move(offsets), std::move(columns), std::move(values));
+}
+
+HermitianCsrMatrix<CompiledExpression::CoeffType>
+CompiledExpression::hermitian_matrix(const Basis& basis) const {
+  const std::size_t size = basis.size();
+  const auto threads = static_cast<std::size_t>(omp_get_max_threads());
+
+  struct Triplet {
+    std::size_t row;
+    std::size_t column;
+    CoeffType value;
+  };
+
+  // Elements of the upper triangle, in no particular order.
+  std::vector<std::vector<Triplet>> chunks(threads);
+#pragma omp parallel
+  {
+    auto& chunk = chunks[static_cast<std::size_t>(omp_get_thread_num())];
+    Workspace workspace;
+#pragma omp for schedule(dynamic, 64)
+    for (std::size_t r = 0; r < size; r++) {
+      half_row(basis, r, workspace);
+      for (const auto& [column, value] : workspace.entries) {
+        if (column >= r) {
+          chunk.push_back({r, column, value});
+        } else {
+          chunk.push_back({column, r, std::conj(value)});
+        }
+      }
+    }
+  }
+
+  // Bucket the triplets by row, then sort and merge every row.
+  std::vector<std::size_t> offsets(size + 1, 0);
+  for (const auto& chunk : chunks) {
+    for (const Triplet& triplet : chunk) {
+      offsets[triplet.row + 1]++;
+    }
+  }
+  for (std::size_t r = 0; r < size; r++) {
+    offsets[r + 1] += offsets[r];
+  }
+  std::vector<Entry> entries(offsets[size]);
+  std::vector<std::size_t> next(offsets.begin(), offsets.end() - 1);
+  for (auto& chunk : chunks) {
+    for (const Triplet& triplet : chunk) {
+      entries[next[triplet.row]++] = {triplet.column, triplet.value};
+    }
+    chunk = {};
+  }
+
+  std::vector<std::size_t> counts(size + 1, 0);
+#pragma omp parallel for schedule(dynamic, 256)
+  for (std::size_t r = 0; r < size; r++) {
+    auto first = entries.begin() + static_cast<std::ptrdiff_t>(offsets[r]);
+    auto last = entries.begin() + static_cast<std::ptrdiff_t>(offsets[r + 1]);
+    std::sort(first, last, [](const Entry& a, const Entry& b) {
+      return a.column < b.column;
+    });
+    auto out = first;
+    for (auto it = first; it != last; ++it) {
+      if (out != first && (out - 1)->column == it->column) {
+        (out - 1)->value += it->value;
+      } else {
+        *out++ = *it;
+      }
+    }
+    counts[r + 1] = static_cast<std::size_t>(out - first);
+  }
+  for (std::size_t r = 0; r < size; r++) {
+    counts[r + 1] += counts[r];
+  }
+
+  std::vector<std::size_t> columns(counts[size]);
+  std::vector<CoeffType> values(counts[size]);
+#pragma omp parallel for schedule(static)
+  for (std::size_t r = 0; r < size; r++) {
+    for (std::size_t k = 0; k < counts[r + 1] - counts[r]; k++) {
+      columns[counts[r] + k] = entries[offsets[r] + k].column;
+      values[counts[r] + k] = entries[offsets[r] + k].value;
+    }
+  }
+  return HermitianCsrMatrix<CoeffType>(CsrMatrix<CoeffType>(
+      size, std::move(counts), std::move(columns), std::move(values)));
+}
+
+void CompiledExpression::fill_row(
+    const Basis& row_basis, std::size_t row, const Basis& column_basis,
+    Workspace& workspace, RowPart part) const {
+  auto& entries = workspace.entries;
+  entries.clear();
+
+  const BasisElement& state = row_basis.elements()[row];
+  const bool same_basis = &row_basis == &column_basis;
+
+  auto push = [&](const BasisElement& element, CoeffType value) {
+    std::size_t column = column_basis.find(element);
+    if (column != column_basis.size()) {
+      entries.push_back({column, value});
+    }
+  };
+
+  // Normal orders O^dagger |state> and reads off the coefficients, which is
+  // what Model used to do for every term.
+  auto normal_order = [&](const std::vector<Term>& adjoint_terms) {
+    if (adjoint_terms.empty()) {
+      return;
+    }
+    workspace.terms.clear();
+    for (const Term& term : adjoint_terms) {
+      workspace.terms.push_back(term.product(state));
+    }
+    for (const auto& [operators, coefficient] :
+         NormalOrderer(workspace.terms).terms()) {
+      if (operators.empty() ||
+          operators.back().type() == Operator::Type::Creation) {
+        push(operators, std::conj(coefficient));
+      }
+    }
+  };
+
+  // Entries from the normal ordering fallback, which always computes full
+  // rows, start here.
+  std::size_t fallback = 0;
+
+  if (!is_fermionic_state(state)) {
+    LIBMB_ASSERT(part != RowPart::Half);
+    normal_order(m_adjoint_terms);
+  } else {
+    const std::uint64_t mask = occupation_mask(state);
+    const bool half = part == RowPart::Half;
+
+    if (part != RowPart::OffDiagonal && !m_diagonal.empty()) {
+      if (same_basis) {
+        entries.push_back({row, diagonal_value(mask)});
+      } else {
+        push(state, diagonal_value(mask));
+      }
+    }
+
+    // <row| c^dagger_i c_j |column> is the sign picked up by
+    // c^dagger_j c_i |row>, so the adjoint string is applied to the row
+    // state: creation operators annihilate and vice versa, read left to right.
+    auto emit = [&](std::uint64_t target, bool parity, CoeffType coefficient) {
+      fermionic_state(target, workspace.element);
+      push(workspace.element, parity ? -coefficient : coefficient);
+    };
+
+    for (const auto& [to, from, coefficient] :
+         std::span(m_hopping).first(half ? m_half_hopping : m_hopping.size())) {
+      std::uint64_t target = mask;
+      bool parity = false;
+      if (annihilate_slot(target, to, parity) &&
+          create_slot(target, from, parity)) {
+        emit(target, parity, coefficient);
+      }
+    }
+
+    for (const auto& [slots, coefficient] : std::span(m_two_body).first(
+             half ? m_half_two_body : m_two_body.size())) {
+      std::uint64_t target = mask;
+      bool parity = false;
+      if (annihilate_slot(target, slots[0], parity) &&
+          annihilate_slot(target, slots[1], parity) &&
+          create_slot(target, slots[2], parity) &&
+          create_slot(target, slots[3], parity)) {
+        emit(target, parity, coefficient);
+      }
+    }
+
+    for (const Term& term : std::span(m_fermionic).first(
+             half ? m_half_fermionic : m_fermionic.size())) {
+      std::uint64_t target = mask;
+      bool parity = false;
+      bool nonzero = true;
+      for (const Operator& op : term.operators()) {
+        nonzero = op.type() == Operator::Type::Creation
+                      ? annihilate_slot(target, fermion_slot(op), parity)
+                      : create_slot(target, fermion_slot(op), parity);
+        if (!nonzero) {
+          break;
+        }
+      }
+      if (nonzero) {
+        emit(target, parity, term.coefficient());
+      }
+    }
+
+    fallback = entries.size();
+    normal_order(m_generic_adjoint_terms);
+  }
+
+  if (part == RowPart::Half) {
+    entries.erase(
+        std::remove_if(
+            entries.begin() + static_cast<std::ptrdiff_t>(fallback),
+            entries.end(),
+            [&](const Entry& entry) { return entry.column < row; }),
+        entries.end());
+  }
+
+  std::sort(entries.begin(), entries.end(), [](const auto& a, const auto& b) {
+    return a.column < b.column;
+  });
+  std::size_t size = 0;
+  for (std::size_t k = 0; k < entries.size(); k++) {
+    if (size > 0 && entries[size - 1].column == entries[k].column) {
+      entries[size - 1].value += entries[k].value;
+    } else {
+      entries[size++] = entries[k];
+    }
+  }
+  entries.resize(size);
+  std::erase_if(entries, [&](const Entry& entry) {
+    return entry.value == CoeffType{} ||
+           (part == RowPart::OffDiagonal && entry.column == row);
+  });
+}
@@ -0,0 +1,284 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Assert.h"
+#include "Basis.h"
+#include "CsrMatrix.h"
+#include "Expression.h"
+#include "HermitianCsrMatrix.h"
+#include "Term.h"
+
+// An operator compiled once into a typed representation that is cheap to
+// evaluate on basis states. The terms are normal ordered, deduplicated and
+// split into
+//
+//   * diagonal terms: products of fermionic number operators (or constants),
+//   * hopping terms: c^dagger_i c_j between different spin-orbitals,
+//   * two-body terms: c^dagger_a c^dagger_b c_c c_d,
+//   * longer fermionic strings,
+//   * and a generic fallback for everything involving bosons, which is
+//     evaluated by normal ordering its product with the basis element.
+//
+// Fermionic terms act directly on the occupation bitmask of a state, in which
+// slot 2 * orbital + spin is set when that spin-orbital is occupied. States
+// are c^dagger_{s_1} ... c^dagger_{s_n} |0> with ascending slots, as generated
+// by FermionicBasis.
+//
+// Matrix elements are produced a row at a time. Row r holds <r|O|c> for every
+// state c, which is obtained by acting with the adjoint of each term on |r>.
+class CompiledExpression {
+ public:
+  using CoeffType = Term::CoeffType;
+
+  // Product of the number operators of the slots set in `mask`.
+  struct DiagonalTerm {
+    std::uint64_t mask;
+    CoeffType coefficient;
+  };
+
+  // c^dagger_to c_from, with to != from.
+  struct HoppingTerm {
+    std::uint8_t to;
+    std::uint8_t from;
+    CoeffType coefficient;
+  };
+
+  // c^dagger_{slots[0]} c^dagger_{slots[1]} c_{slots[2]} c_{slots[3]}.
+  struct TwoBodyTerm {
+    std::array<std::uint8_t, 4> slots;
+    CoeffType coefficient;
+  };
+
+  struct Entry {
+    std::size_t column;
+    CoeffType value;
+  };
+
+  // Scratch space for row(); one per thread.
+  struct Workspace {
+    std::vector<Entry> entries;
+    BasisElement element;
+    std::vector<Term> terms;
+  };
+
+  explicit CompiledExpression(const std::vector<Term>& terms);
+
+  explicit CompiledExpression(const Expression& expression);
+
+  const std::vector<DiagonalTerm>& diagonal_terms() const {
+    return m_diagonal;
+  }
+
+  const std::vector<HoppingTerm>& hopping_terms() const { return m_hopping; }
+
+  const std::vector<TwoBodyTerm>& two_body_terms() const { return m_two_body; }
+
+  const std::vector<Term>& fermionic_terms() const { return m_fermionic; }
+
+  const std::vector<Term>& generic_terms() const { return m_generic; }
+
+  // Fills workspace.entries with the nonzero <row|O|column>, where the row
+  // state is taken from `row_basis` and the column states from
+  // `column_basis`. Entries are sorted by column and have distinct columns.
+  void row(
+      const Basis& row_basis, std::size_t row, const Basis& column_basis,
+      Workspace& workspace) const {
+    fill_row(row_basis, row, column_basis, workspace, RowPart::All);
+  }
+
+  // Same as row() within a single basis, but without the diagonal entry.
+  void off_diagonal_row(
+      const Basis& basis, std::size_t row, Workspace& workspace) const {
+    fill_row(basis, row, basis, workspace, RowPart::OffDiagonal);
+  }
+
+  // Whether the operator equals its adjoint.
+  bool hermitian() const { return m_hermitian; }
+
+  // Whether the operator is quadratic in fermions, sum_ij h_ij c^dagger_i c_j
+  // plus a constant, as the hopping part of the Hubbard models.
+  bool quadratic() const {
+    return m_pairs.empty() && m_higher_diagonal.empty() &&
+           m_two_body.empty() && m_fermionic.empty() && m_generic.empty();
+  }
+
+  // For a Hermitian operator, the row computed with only one term of each
+  // pair T, T^dagger, which is about half the work of row(). An entry with
+  // column >= row adds to the element (row, column); one with column < row
+  // adds to the element (row, column) of the lower triangle, i.e. its
+  // conjugate adds to (column, row). Summed over all the rows, this gives the
+  // upper triangle of the matrix.
+  //
+  // Only fermionic states are orthonormal, so only in a fermionic basis is
+  // the matrix of a Hermitian operator itself Hermitian.
+  void half_row(
+      const Basis& basis, std::size_t row, Workspace& workspace) const {
+    LIBMB_ASSERT(m_hermitian);
+    fill_row(basis, row, basis, workspace, RowPart::Half);
+  }
+
+  // <row|O|row>.
+  CoeffType diagonal(
+      const Basis& basis, std::size_t row, Workspace& workspace) const;
+
+  // <state|O|state> for the fermionic state with occupation bitmask
+  // `occupation`, ignoring the generic terms.
+  CoeffType diagonal_value(std::uint64_t occupation) const;
+
+  // The diagonal of O in `basis`, as a dense vector.
+  std::vector<CoeffType> diagonal(const Basis& basis) const;
+
+  // The matrix <r|O|c> in `basis`.
+  CsrMatrix<CoeffType> matrix(const Basis& basis) const;
+
+  // The upper triangle of the matrix of a Hermitian operator, assembled from
+  // half_row().
+  HermitianCsrMatrix<CoeffType> hermitian_matrix(const Basis& basis) const;
+
+  // y = O x, without assembling the matrix.
+  template <typename Vec>
+  void apply(const Basis& basis, const Vec& x, Vec& y) const {
+    const std::size_t size = basis.size();
+#pragma omp parallel
+    {
+      Workspace workspace;
+#pragma omp for schedule(dynamic, 64)
+      for (std::size_t r = 0; r < size; r++) {
+        row(basis, r, basis, workspace);
+        CoeffType sum{};
+        for (const auto& [column, value] : workspace.entries) {
+          sum += value * x[column];
+        }
+        y[r] = sum;
+      }
+    }
+  }
+
+  // y = O x for a state x given in `source`, with the result expressed in
+  // `target`. Components of O x outside of `target` are dropped.
+  template <typename Vec>
+  void apply(
+      const Basis& source, const Vec& x, const Basis& target, Vec& y) const {
+    const std::size_t size = target.size();
+#pragma omp parallel
+    {
+      Workspace workspace;
+#pragma omp for schedule(dynamic, 64)
+      for (std::size_t r = 0; r < size; r++) {
+        row(target, r, source, workspace);
+        CoeffType sum{};
+        for (const auto& [column, value] : workspace.entries) {
+          sum += value * x[column];
+        }
+        y[r] = sum;
+      }
+    }
+  }
+
+  // Y = O X for a block of k vectors stored interleaved, X[c * k + j] being
+  // element c of vector j. Every row is generated once for all k vectors.
+  template <typename Vec>
+  void apply_block(
+      const Basis& basis, const Vec& x, Vec& y, std::size_t k) const {
+    const std::size_t size = basis.size();
+#pragma omp parallel
+    {
+      Workspace workspace;
+#pragma omp for schedule(dynamic, 64)
+      for (std::size_t r = 0; r < size; r++) {
+        row(basis, r, basis, workspace);
+        auto* out = &y[r * k];
+        for (std::size_t j = 0; j < k; j++) {
+          out[j] = 0.0;
+        }
+        for (const auto& [column, value] : workspace.entries) {
+          const auto* in = &x[column * k];
+          for (std::size_t j = 0; j < k; j++) {
+            out[j] += value * in[j];
+          }
+        }
+      }
+    }
+  }
+
+  // <x|O|x>, for a state x given in `basis`.
+  template <typename Vec>
+  CoeffType expectation(const Basis& basis, const Vec& x) const {
+    const std::size_t size = basis.size();
+    double real = 0.0;
+    double imag = 0.0;
+#pragma omp parallel reduction(+ : real, imag)
+    {
+      Workspace workspace;
+#pragma omp for schedule(dynamic, 64)
+      for (std::size_t r = 0; r < size; r++) {
+        row(basis, r, basis, workspace);
+        CoeffType sum{};
+        for (const auto& [column, value] : workspace.entries) {
+          sum += value * x[column];
+        }
+        sum *= std::conj(CoeffType(x[r]));
+        real += sum.real();
+        imag += sum.imag();
+      }
+    }
+    return {real, imag};
+  }
+
+ private:
+  enum class RowPart { All, OffDiagonal, Half };
+
+  // coefficient * popcount(occupation & mask): number operators sharing a
+  // coefficient.
+  struct DensityGroup {
+    std::uint64_t mask;
+    CoeffType coefficient;
+  };
+
+  // coefficient * popcount(occupation & (occupation >> shift) & mask):
+  // products n_s n_{s + shift} sharing a coefficient, with s in `mask`.
+  struct PairGroup {
+    std::uint64_t mask;
+    std::size_t shift;
+    CoeffType coefficient;
+  };
+
+  void compile(const Expression& expression);
+
+  void group_diagonal_terms();
+
+  void split_hermitian_pairs(const Expression::ExpressionMap& terms);
+
+  void fill_row(
+      const Basis& row_basis, std::size_t row, const Basis& column_basis,
+      Workspace& workspace, RowPart part) const;
+
+  std::vector<DiagonalTerm> m_diagonal;
+  CoeffType m_constant{};
+  std::vector<DensityGroup> m_densities;
+  std::vector<PairGroup> m_pairs;
+  std::vector<DiagonalTerm> m_higher_diagonal;
+  std::vector<HoppingTerm> m_hopping;
+  std::vector<TwoBodyTerm> m_two_body;
+  std::vector<Term> m_fermionic;
+  std::vector<Term> m_generic;
+
+  // For Hermitian operators, the off-diagonal terms are partitioned so that
+  // the first ones hold one term of every pair T, T^dagger.
+  bool m_hermitian = false;
+  std::size_t m_half_hopping = 0;
+  std::size_t m_half_two_body = 0;
+  std::size_t m_half_fermionic = 0;
+
+  // Adjoints of all the terms and of the generic ones, used by the normal
+  // ordering fallback.
+  std::vector<Term> m_adjoint_terms;
+  std::vector<Term> m_generic_adjoint_terms;
+};
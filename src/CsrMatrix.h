@@ -0,0 +1,102 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "Assert.h"
+
+// Compressed sparse row matrix. The entries of row r are at positions
+// row_offsets()[r] to row_offsets()[r + 1] of columns() and values(), sorted
+// by column.
+template <typename T>
+class CsrMatrix {
+ public:
+  CsrMatrix() = default;
+
+  CsrMatrix(
+      std::size_t cols, std::vector<std::size_t> row_offsets,
+      std::vector<std::size_t> columns, std::vector<T> values)
+      : m_cols{cols},
+        m_row_offsets{std::move(row_offsets)},
+        m_columns{std::move(columns)},
+        m_values{std::move(values)} {
+    LIBMB_ASSERT(!m_row_offsets.empty());
+    LIBMB_ASSERT(m_row_offsets.back() == m_columns.size());
+    LIBMB_ASSERT(m_columns.size() == m_values.size());
+  }
+
+  std::size_t rows() const {
+    return m_row_offsets.empty() ? 0 : m_row_offsets.size() - 1;
+  }
+
+  std::size_t cols() const { return m_cols; }
+
+  std::size_t nonzeros() const { return m_values.size(); }
+
+  const std::vector<std::size_t>& row_offsets() const { return m_row_offsets; }
+
+  const std::vector<std::size_t>& columns() const { return m_columns; }
+
+  const std::vector<T>& values() const { return m_values; }
+
+  std::vector<T>& values() { return m_values; }
+
+  T operator()(std::size_t i, std::size_t j) const {
+    auto first =
+        m_columns.begin() + static_cast<std::ptrdiff_t>(m_row_offsets[i]);
+    auto last =
+        m_columns.begin() + static_cast<std::ptrdiff_t>(m_row_offsets[i + 1]);
+    auto it = std::lower_bound(first, last, j);
+    if (it == last || *it != j) {
+      return T{};
+    }
+    return m_values[static_cast<std::size_t>(it - m_columns.begin())];
+  }
+
+  // y = A x.
+  template <typename Vec>
+  void multiply(const Vec& x, Vec& y) const {
+    const std::size_t size = rows();
+#pragma omp parallel for schedule(dynamic, 256)
+    for (std::size_t r = 0; r < size; r++) {
+      T sum{};
+      for (std::size_t k = m_row_offsets[r]; k < m_row_offsets[r + 1]; k++) {
+        sum += m_values[k] * x[m_columns[k]];
+      }
+      y[r] = sum;
+    }
+  }
+
+  // Y = A X for a block of k vectors stored interleaved, X[c * k + j] being
+  // element c of vector j. Each entry of the matrix is read once for all k
+  // vectors.
+  template <typename Vec>
+  void multiply_block(const Vec& x, Vec& y, std::size_t k) const {
+    const std::size_t size = rows();
+#pragma omp parallel for schedule(dynamic, 256)
+    for (std::size_t r = 0; r < size; r++) {
+      auto* out = &y[r * k];
+      for (std::size_t j = 0; j < k; j++) {
+        out[j] = T{};
+      }
+      for (std::size_t e = m_row_offsets[r]; e < m_row_offsets[r + 1]; e++) {
+        const T value = m_values[e];
+        const auto* in = &x[m_columns[e] * k];
+        for (std::size_t j = 0; j < k; j++) {
+          out[j] += value * in[j];
+        }
+      }
+    }
+  }
+
+ private:
+  std::size_t m_cols = 0;
+  std::vector<std::size_t> m_row_offsets;
+  std::vector<std::size_t> m_columns;
+  std::vector<T> m_values;
+};
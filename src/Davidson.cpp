@@ -0,0 +1,194 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "Davidson.h"
+
+#include <algorithm>
+#include <cmath>
+#include <random>
+#include <utility>
+#include <vector>
+
+EigenResult davidson(const LinearOperator& op, const DavidsonOptions& options) {
+  const std::size_t n = op.size();
+  const std::size_t roots = std::min(options.roots, n);
+  EigenResult result;
+  if (roots == 0) {
+    result.converged = true;
+    return result;
+  }
+  // The search space must hold the wanted pairs and their corrections, and
+  // a collapse keeps at least the wanted pairs with room for the
+  // corrections. A space as large as the operator is never collapsed.
+  const std::size_t max_basis = std::min(
+      n, std::max(
+             2 * roots, options.max_basis == 0
+                            ? std::max<std::size_t>(20, 8 * roots)
+                            : options.max_basis));
+  const std::size_t restart_size = std::clamp(
+      options.restart_size == 0 ? 2 * roots : options.restart_size, roots,
+      std::max(roots, max_basis - roots));
+
+  // Operators that do not know their diagonal are probed with blocks of unit
+  // vectors, at the cost of n products.
+  std::vector<double> diagonal(n);
+  if (op.has_diagonal()) {
+    for (std::size_t i = 0; i < n; i++) {
+      diagonal[i] = op.diagonal()[i].real();
+    }
+  } else {
+    const std::size_t width = std::min<std::size_t>(n, 16);
+    ComplexVector units;
+    ComplexVector images;
+    for (std::size_t first = 0; first < n; first += width) {
+      const std::size_t k = std::min(width, n - first);
+      units.assign(n * k, Complex{});
+      for (std::size_t j = 0; j < k; j++) {
+        units[(first + j) * k + j] = 1.0;
+      }
+      op.apply_block(units, images, k);
+      result.applications += k;
+      for (std::size_t j = 0; j < k; j++) {
+        diagonal[first + j] = images[(first + j) * k + j].real();
+      }
+    }
+  }
+
+  std::mt19937_64 rng(options.seed);
+  // The search space V, A V, and the projection H = V^H A V with leading
+  // dimension max_basis.
+  std::vector<ComplexVector> basis;
+  std::vector<ComplexVector> images;
+  ComplexVector h(max_basis * max_basis);
+  auto at = [&](std::size_t i, std::size_t j) -> Complex& {
+    return h[i + j * max_basis];
+  };
+
+  // Orthonormalises the block `t` of width k against the search space,
+  // applies the operator to it, and appends both to the space.
+  auto extend = [&](ComplexVector& t, std::size_t k) {
+    orthonormalize(t, k, basis, 1, rng);
+    ComplexVector at_block;
+    op.apply_block(t, at_block, k);
+    result.applications += k;
+    const std::size_t first = basis.size();
+    for (std::size_t j = 0; j < k; j++) {
+      basis.push_back(block_column(t, k, j));
+      images.push_back(block_column(at_block, k, j));
+    }
+    for (std::size_t j = first; j < basis.size(); j++) {
+      for (std::size_t i = 0; i <= j; i++) {
+        at(i, j) = dot(basis[i], images[j]);
+        at(j, i) = std::conj(at(i, j));
+      }
+      at(j, j) = at(j, j).real();
+    }
+  };
+
+  // Linear combination of `vectors` with coefficients column j of the
+  // dim x dim matrix `coefficients`.
+  auto combine = [](const std::vector<ComplexVector>& vectors,
+                    const ComplexVector& coefficients, std::size_t j) {
+    const std::size_t dim = vectors.size();
+    ComplexVector x(vectors[0].size());
+    for (std::size_t i = 0; i < dim; i++) {
+      axpy(coefficients[i + j * dim], vectors[i], x);
+    }
+    return x;
+  };
+
+  {
+    // Random vectors, so that every symmetry sector is present, weighted
+    // towards the states of low diagonal energy.
+    const std::size_t start = std::min(restart_size, n);
+    const double lowest = *std::min_element(diagonal.begin(), diagonal.end());
+    ComplexVector t = random_vector(n * start, rng);
+#pragma omp parallel for schedule(static)
+    for (std::size_t i = 0; i < n; i++) {
+      for (std::size_t j = 0; j < start; j++) {
+        t[i * start + j] /= 1.0 + diagonal[i] - lowest;
+      }
+    }
+    extend(t, start);
+  }
+
+  while (true) {
+    const std::size_t dim = basis.size();
+    ComplexVector projection(dim * dim);
+    for (std::size_t j = 0; j < dim; j++) {
+      for (std::size_t i = 0; i < dim; i++) {
+        projection[i + j * dim] = at(i, j);
+      }
+    }
+    const HermitianEigen ritz = hermitian_eigen(std::move(projection), dim);
+
+    // Residuals A x - theta x of the wanted pairs, and the preconditioned
+    // corrections of those that have not converged.
+    std::vector<ComplexVector> corrections;
+    result.converged = true;
+    result.residuals.assign(roots, 0.0);
+    for (std::size_t i = 0; i < roots; i++) {
+      const double theta = ritz.values[i];
+      ComplexVector r = combine(images, ritz.vectors, i);
+      axpy(-theta, combine(basis, ritz.vectors, i), r);
+      result.residuals[i] = norm(r);
+      if (result.residuals[i] <=
+          options.tolerance * std::max(1.0, std::abs(theta))) {
+        continue;
+      }
+      result.converged = false;
+#pragma omp parallel for schedule(static)
+      for (std::size_t k = 0; k < n; k++) {
+        double denominator = diagonal[k] - theta;
+        if (std::abs(denominator) < 1e-8) {
+          denominator = std::copysign(1e-8, denominator);
+        }
+        r[k] /= denominator;
+      }
+      corrections.push_back(std::move(r));
+    }
+
+    // A failed Rayleigh-Ritz step ends the run, unconverged.
+    result.converged = result.converged && ritz.converged;
+    const std::size_t k = corrections.size();
+    const bool restart = dim + k > max_basis;
+    if (result.converged || !ritz.converged || dim + k > n ||
+        (restart && result.restarts == options.max_restarts)) {
+      result.values.assign(
+          ritz.values.begin(),
+          ritz.values.begin() + static_cast<std::ptrdiff_t>(roots));
+      for (std::size_t i = 0; i < roots; i++) {
+        result.vectors.push_back(combine(basis, ritz.vectors, i));
+      }
+      return result;
+    }
+
+    if (restart) {
+      // Collapse the space onto the lowest Ritz vectors, whose images are
+      // combinations of the stored ones.
+      const std::size_t keep = std::min(restart_size, dim);
+      std::vector<ComplexVector> kept_basis;
+      std::vector<ComplexVector> kept_images;
+      for (std::size_t i = 0; i < keep; i++) {
+        kept_basis.push_back(combine(basis, ritz.vectors, i));
+        kept_images.push_back(combine(images, ritz.vectors, i));
+      }
+      basis = std::move(kept_basis);
+      images = std::move(kept_images);
+      std::fill(h.begin(), h.end(), Complex{});
+      for (std::size_t i = 0; i < keep; i++) {
+        at(i, i) = ritz.values[i];
+      }
+      result.restarts++;
+    }
+
+    ComplexVector t(n * k);
+#pragma omp parallel for schedule(static)
+    for (std::size_t i = 0; i < n; i++) {
+      for (std::size_t j = 0; j < k; j++) {
+        t[i * k + j] = corrections[j][i];
+      }
+    }
+    extend(t, k);
+  }
+}
@@ -0,0 +1,39 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "LinearOperator.h"
+
+struct DavidsonOptions {
+  // Number of lowest eigenpairs wanted, at most the size of the operator.
+  std::size_t roots = 1;
+  // Dimension of the search space at which it is collapsed; zero means
+  // max(20, 8 * roots). It is raised to 2 * roots and lowered to the size of
+  // the operator.
+  std::size_t max_basis = 0;
+  // Number of Ritz vectors kept when collapsing; zero means 2 * roots. It is
+  // clamped to [roots, max_basis - roots].
+  std::size_t restart_size = 0;
+  std::size_t max_restarts = 100;
+  // A pair converges when ||A x - lambda x|| <= tolerance * max(1, |lambda|).
+  double tolerance = 1e-9;
+  // Seed for the random vectors that replace linearly dependent corrections.
+  std::uint64_t seed = 0;
+};
+
+// Lowest eigenpairs of the Hermitian operator `op` by the Davidson method,
+// preconditioned with the diagonal of the operator. An operator without a
+// diagonal is applied to every unit vector to find it.
+//
+// The search starts from random vectors weighted towards the smallest
+// diagonal elements; unit vectors would miss the symmetry sectors of the
+// operator they do not belong to. Every iteration adds the corrections
+// (D - theta)^-1 r of all unconverged Ritz pairs, applying the operator to
+// them as one block. Where H is dominated by its diagonal, as the Hubbard
+// model at large U, this needs far fewer products than Lanczos.
+EigenResult davidson(
+    const LinearOperator& op, const DavidsonOptions& options = {});
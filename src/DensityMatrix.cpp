@@ -0,0 +1,180 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "DensityMatrix.h"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <utility>
+
+#include "Assert.h"
+#include "FermionicState.h"
+
+namespace {
+
+// Slots of the bits set in `mask`, in ascending order.
+std::vector<std::size_t> slots_of(std::uint64_t mask) {
+  std::vector<std::size_t> result;
+  for (; mask != 0; mask &= mask - 1) {
+    result.push_back(static_cast<std::size_t>(std::countr_zero(mask)));
+  }
+  return result;
+}
+
+}  // namespace
+
+Complex DensityMatrices::two(
+    std::size_t i, std::size_t j, std::size_t k, std::size_t l) const {
+  if (i == j || k == l) {
+    return {};
+  }
+  bool negate = false;
+  if (i > j) {
+    std::swap(i, j);
+    negate = !negate;
+  }
+  if (k > l) {
+    std::swap(k, l);
+    negate = !negate;
+  }
+  auto position = [&](std::size_t slot) {
+    auto it = std::lower_bound(
+        two_body_slots.begin(), two_body_slots.end(), slot);
+    LIBMB_ASSERT(it != two_body_slots.end() && *it == slot);
+    return static_cast<std::size_t>(it - two_body_slots.begin());
+  };
+  const std::size_t m = two_body_slots.size();
+  const std::size_t pairs = m * (m - 1) / 2;
+  auto pair = [&](std::size_t a, std::size_t b) {
+    return a * m - a * (a + 1) / 2 + b - a - 1;
+  };
+  const Complex value =
+      two_body[pair(position(i), position(j)) +
+               pair(position(k), position(l)) * pairs];
+  return negate ? -value : value;
+}
+
+DensityMatrices density_matrices(
+    const StateVector& state, const DensityMatrixOptions& options) {
+  const Basis& basis = state.basis();
+  const ComplexVector& x = state.amplitudes();
+  const std::size_t size = basis.size();
+
+  DensityMatrices result;
+  result.slots = 2 * basis.orbitals();
+  LIBMB_ASSERT(result.slots <= 64);
+  const std::size_t slots = result.slots;
+  const std::uint64_t all =
+      slots == 64 ? ~std::uint64_t{0} : slot_bit(slots) - 1;
+  result.one_body.assign(slots * slots, Complex{});
+
+  std::uint64_t two_body_mask = 0;
+  if (options.two_body) {
+    if (options.orbitals.empty()) {
+      two_body_mask = all;
+    }
+    for (std::size_t orbital : options.orbitals) {
+      LIBMB_ASSERT(orbital < basis.orbitals());
+      two_body_mask |= slot_bit(2 * orbital) | slot_bit(2 * orbital + 1);
+    }
+  }
+  result.two_body_slots = slots_of(two_body_mask);
+  const std::size_t m = result.two_body_slots.size();
+  const std::size_t pairs = m * (m - 1) / 2;
+  result.two_body.assign(pairs * pairs, Complex{});
+
+  // Position of every slot among the two-body slots, and the number of a
+  // pair of positions a < b.
+  std::array<std::size_t, 64> position{};
+  for (std::size_t a = 0; a < m; a++) {
+    position[result.two_body_slots[a]] = a;
+  }
+  auto pair = [&](std::size_t i, std::size_t j) {
+    const std::size_t a = position[i];
+    const std::size_t b = position[j];
+    return a * m - a * (a + 1) / 2 + b - a - 1;
+  };
+
+#pragma omp parallel
+  {
+    ComplexVector one(slots * slots);
+    ComplexVector two(pairs * pairs);
+    BasisElement element;
+
+    // <target| x_c, with the sign of the operator string.
+    auto amplitude = [&](std::uint64_t target, std::uint64_t mask,
+                         std::size_t c, bool parity) -> Complex {
+      std::size_t r = c;
+      if (target != mask) {
+        fermionic_state(target, element);
+        r = basis.find(element);
+        if (r == size) {
+          return {};
+        }
+      }
+      const Complex value = std::conj(x[r]) * x[c];
+      return parity ? -value : value;
+    };
+
+#pragma omp for schedule(dynamic, 64)
+    for (std::size_t c = 0; c < size; c++) {
+      if (x[c] == Complex{}) {
+        continue;
+      }
+      LIBMB_ASSERT(is_fermionic_state(basis.elements()[c]));
+      const std::uint64_t mask = occupation_mask(basis.elements()[c]);
+      const double weight = std::norm(x[c]);
+
+      // c^dagger_i c_j |c>, for occupied j and i empty or equal to j.
+      for (std::uint64_t from = mask; from != 0; from &= from - 1) {
+        const auto j = static_cast<std::size_t>(std::countr_zero(from));
+        one[j + j * slots] += weight;
+        for (std::uint64_t to = all & ~mask; to != 0; to &= to - 1) {
+          const auto i = static_cast<std::size_t>(std::countr_zero(to));
+          std::uint64_t target = mask;
+          bool parity = false;
+          annihilate_slot(target, j, parity);
+          create_slot(target, i, parity);
+          one[i + j * slots] += amplitude(target, mask, c, parity);
+        }
+      }
+
+      // c^dagger_i c^dagger_j c_l c_k |c>, for occupied k < l and i < j
+      // empty once they are removed.
+      const std::uint64_t occupied = mask & two_body_mask;
+      for (std::uint64_t ks = occupied; ks != 0; ks &= ks - 1) {
+        const auto k = static_cast<std::size_t>(std::countr_zero(ks));
+        for (std::uint64_t ls = ks & (ks - 1); ls != 0; ls &= ls - 1) {
+          const auto l = static_cast<std::size_t>(std::countr_zero(ls));
+          std::uint64_t removed = mask;
+          bool removed_parity = false;
+          annihilate_slot(removed, k, removed_parity);
+          annihilate_slot(removed, l, removed_parity);
+          const std::size_t q = pair(k, l);
+          const std::uint64_t empty = two_body_mask & ~removed;
+          for (std::uint64_t is = empty; is != 0; is &= is - 1) {
+            const auto i = static_cast<std::size_t>(std::countr_zero(is));
+            for (std::uint64_t js = is & (is - 1); js != 0; js &= js - 1) {
+              const auto j = static_cast<std::size_t>(std::countr_zero(js));
+              std::uint64_t target = removed;
+              bool parity = removed_parity;
+              create_slot(target, j, parity);
+              create_slot(target, i, parity);
+              two[pair(i, j) + q * pairs] +=
+                  amplitude(target, mask, c, parity);
+            }
+          }
+        }
+      }
+    }
+
+#pragma omp critical
+    {
+      axpy(1.0, one, result.one_body);
+      axpy(1.0, two, result.two_body);
+    }
+  }
+  return result;
+}
@@ -0,0 +1,53 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "LinearAlgebra.h"
+#include "StateVector.h"
+
+struct DensityMatrixOptions {
+  // Whether to compute the two-particle density matrix.
+  bool two_body = false;
+  // Orbitals to which the two-particle density matrix is restricted; empty
+  // means all of them.
+  std::vector<std::size_t> orbitals;
+};
+
+// Reduced density matrices of a state, indexed by spin-orbital
+// 2 * orbital + spin.
+struct DensityMatrices {
+  // Number of spin-orbitals, twice the number of orbitals of the basis.
+  std::size_t slots = 0;
+  // <c^dagger_i c_j> at i + j * slots. Its eigenvectors, as given by
+  // hermitian_eigen(), are the natural spin-orbitals.
+  ComplexVector one_body;
+  // Ascending spin-orbitals spanned by the two-particle density matrix.
+  std::vector<std::size_t> two_body_slots;
+  // <c^dagger_i c^dagger_j c_l c_k> for the pairs p = (i, j) and q = (k, l)
+  // of two_body_slots with i < j and k < l, at p + q * pairs, the pairs being
+  // numbered in lexicographic order.
+  ComplexVector two_body;
+
+  Complex one(std::size_t i, std::size_t j) const {
+    return one_body[i + j * slots];
+  }
+
+  // <c^dagger_i c^dagger_j c_l c_k> for spin-orbitals in two_body_slots, in
+  // any order.
+  Complex two(std::size_t i, std::size_t j, std::size_t k, std::size_t l)
+      const;
+};
+
+// The one-particle, and optionally two-particle, reduced density matrices
+// of a state in a fermionic basis, accumulated in one parallel pass.
+//
+// For every basis state the fermions are moved from its occupied to its
+// empty spin-orbitals, iterating over the bits of the occupation mask, with
+// the signs taken from the bits in between; each thread accumulates into its
+// own matrices, which are summed at the end.
+DensityMatrices density_matrices(
+    const StateVector& state, const DensityMatrixOptions& options = {});
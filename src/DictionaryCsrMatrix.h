@@ -0,0 +1,117 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <limits>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "CsrMatrix.h"
+
+// CSR matrix whose values are stored once in a small table, with every
+// nonzero keeping only the index of its value. Lattice Hamiltonians have a
+// handful of distinct matrix elements (+-t, multiples of U, ...), so with
+// 16-bit value indices and 32-bit columns a nonzero takes 6 bytes instead of
+// the 24 of a complex CSR entry, which is what bounds a memory-bound SpMV.
+template <
+    typename T, typename ValueIndex = std::uint16_t,
+    typename ColumnIndex = std::uint32_t>
+class DictionaryCsrMatrix {
+ public:
+  // Returns nothing if the matrix has more distinct values than ValueIndex
+  // can address, or more columns than ColumnIndex can.
+  static std::optional<DictionaryCsrMatrix> compress(
+      const CsrMatrix<T>& matrix) {
+    if (matrix.cols() > 0 &&
+        matrix.cols() - 1 > std::numeric_limits<ColumnIndex>::max()) {
+      return std::nullopt;
+    }
+
+    DictionaryCsrMatrix result;
+    result.m_cols = matrix.cols();
+    result.m_row_offsets = matrix.row_offsets();
+    result.m_columns.reserve(matrix.nonzeros());
+    result.m_value_indices.reserve(matrix.nonzeros());
+
+    std::unordered_map<T, ValueIndex, ValueHash> indices;
+    for (std::size_t k = 0; k < matrix.nonzeros(); k++) {
+      const T& value = matrix.values()[k];
+      auto it = indices.find(value);
+      if (it == indices.end()) {
+        if (result.m_table.size() > std::numeric_limits<ValueIndex>::max()) {
+          return std::nullopt;
+        }
+        it = indices
+                 .emplace(
+                     value, static_cast<ValueIndex>(result.m_table.size()))
+                 .first;
+        result.m_table.push_back(value);
+      }
+      result.m_columns.push_back(
+          static_cast<ColumnIndex>(matrix.columns()[k]));
+      result.m_value_indices.push_back(it->second);
+    }
+    return result;
+  }
+
+  std::size_t rows() const {
+    return m_row_offsets.empty() ? 0 : m_row_offsets.size() - 1;
+  }
+
+  std::size_t cols() const { return m_cols; }
+
+  std::size_t nonzeros() const { return m_columns.size(); }
+
+  // The distinct values of the matrix.
+  const std::vector<T>& table() const { return m_table; }
+
+  const std::vector<std::size_t>& row_offsets() const { return m_row_offsets; }
+
+  const std::vector<ColumnIndex>& columns() const { return m_columns; }
+
+  const std::vector<ValueIndex>& value_indices() const {
+    return m_value_indices;
+  }
+
+  // y = A x, looking up every value in the table on the fly.
+  template <typename Vec>
+  void multiply(const Vec& x, Vec& y) const {
+    const std::size_t size = rows();
+    const T* table = m_table.data();
+#pragma omp parallel for schedule(dynamic, 256)
+    for (std::size_t r = 0; r < size; r++) {
+      T sum{};
+      for (std::size_t k = m_row_offsets[r]; k < m_row_offsets[r + 1]; k++) {
+        sum += table[m_value_indices[k]] * x[m_columns[k]];
+      }
+      y[r] = sum;
+    }
+  }
+
+ private:
+  struct ValueHash {
+    std::size_t operator()(const std::complex<double>& value) const {
+      std::size_t h = std::hash<double>{}(value.real());
+      return h ^ (std::hash<double>{}(value.imag()) + 0x9e3779b9 + (h << 6) +
+                  (h >> 2));
+    }
+
+    std::size_t operator()(double value) const {
+      return std::hash<double>{}(value);
+    }
+  };
+
+  DictionaryCsrMatrix() = default;
+
+  std::size_t m_cols = 0;
+  std::vector<T> m_table;
+  std::vector<std::size_t> m_row_offsets;
+  std::vector<ColumnIndex> m_columns;
+  std::vector<ValueIndex> m_value_indices;
+};
@@ -0,0 +1,203 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "Entanglement.h"
+
+#include <algorithm>
+#include <bit>
+#include <cmath>
+#include <functional>
+#include <map>
+#include <unordered_map>
+#include <utility>
+
+#include "Assert.h"
+#include "FermionicState.h"
+
+namespace {
+
+// Slots of spin up are the even ones.
+constexpr std::uint64_t spin_up_slots = 0x5555555555555555;
+
+int twice_spin(std::uint64_t mask) {
+  return std::popcount(mask & spin_up_slots) -
+         std::popcount(mask & ~spin_up_slots);
+}
+
+// Sign of reordering the creation operators of a state with occupation
+// `a | b` into those of `a` followed by those of `b`.
+bool reorder_parity(std::uint64_t a, std::uint64_t b) {
+  bool parity = false;
+  for (; a != 0; a &= a - 1) {
+    const auto slot = static_cast<std::size_t>(std::countr_zero(a));
+    parity ^= (std::popcount(b & (slot_bit(slot) - 1)) & 1) != 0;
+  }
+  return parity;
+}
+
+struct BlockBuilder {
+  std::unordered_map<std::uint64_t, std::size_t> rows;
+  std::unordered_map<std::uint64_t, std::size_t> columns;
+  std::vector<std::size_t> entry_rows;
+  std::vector<std::size_t> entry_columns;
+  ComplexVector entry_values;
+};
+
+// Eigenvalues of psi psi^dagger for a rows x columns matrix psi with
+// rows <= columns, in decreasing order.
+std::vector<double> gram_eigenvalues(
+    const ComplexVector& psi, std::size_t rows, std::size_t columns) {
+  ComplexVector gram(rows * rows);
+#pragma omp parallel for schedule(dynamic, 16)
+  for (std::size_t j = 0; j < rows; j++) {
+    for (std::size_t i = j; i < rows; i++) {
+      Complex sum{};
+      for (std::size_t l = 0; l < columns; l++) {
+        sum += psi[i + l * rows] * std::conj(psi[j + l * rows]);
+      }
+      gram[i + j * rows] = sum;
+    }
+  }
+  HermitianEigen eigen = hermitian_eigen(std::move(gram), rows);
+  LIBMB_ASSERT(eigen.converged);
+  std::vector<double> values = std::move(eigen.values);
+  for (double& value : values) {
+    value = std::max(value, 0.0);
+  }
+  std::sort(values.begin(), values.end(), std::greater<>());
+  return values;
+}
+
+}  // namespace
+
+std::vector<double> EntanglementSpectrum::values() const {
+  std::vector<double> result;
+  for (const SchmidtBlock& block : blocks) {
+    result.insert(result.end(), block.values.begin(), block.values.end());
+  }
+  std::sort(result.begin(), result.end(), std::greater<>());
+  return result;
+}
+
+double EntanglementSpectrum::entropy() const {
+  double result = 0.0;
+  for (const SchmidtBlock& block : blocks) {
+    for (double p : block.values) {
+      if (p > 0.0) {
+        result -= p * std::log(p);
+      }
+    }
+  }
+  return result;
+}
+
+double EntanglementSpectrum::renyi_entropy(double alpha) const {
+  LIBMB_ASSERT(alpha != 1.0);
+  double trace = 0.0;
+  for (const SchmidtBlock& block : blocks) {
+    for (double p : block.values) {
+      if (p > 0.0) {
+        trace += std::pow(p, alpha);
+      }
+    }
+  }
+  return std::log(trace) / (1.0 - alpha);
+}
+
+EntanglementSpectrum entanglement_spectrum(
+    const StateVector& state, const std::vector<std::size_t>& orbitals,
+    double blocking_threshold) {
+  const Basis& basis = state.basis();
+  const ComplexVector& x = state.amplitudes();
+  LIBMB_ASSERT(2 * basis.orbitals() <= 64);
+
+  std::uint64_t region = 0;
+  for (std::size_t orbital : orbitals) {
+    LIBMB_ASSERT(orbital < basis.orbitals());
+    region |= slot_bit(2 * orbital) | slot_bit(2 * orbital + 1);
+  }
+
+  // Quantum numbers shared by all the components above the threshold, which
+  // decide how rho_A is blocked. Solvers started from random vectors leave
+  // round-off in the other symmetry sectors, which would otherwise prevent
+  // the blocking.
+  const double scale = 1.0 / state.norm();
+  bool fixed_particles = true;
+  bool fixed_spin = true;
+  std::vector<std::uint64_t> masks(basis.size());
+  std::size_t first = basis.size();
+  for (std::size_t k = 0; k < basis.size(); k++) {
+    if (x[k] == Complex{}) {
+      continue;
+    }
+    LIBMB_ASSERT(is_fermionic_state(basis.elements()[k]));
+    masks[k] = occupation_mask(basis.elements()[k]);
+    if (std::abs(scale * x[k]) <= blocking_threshold) {
+      continue;
+    }
+    if (first == basis.size()) {
+      first = k;
+    }
+    const std::uint64_t reference = masks[first];
+    fixed_particles &= std::popcount(masks[k]) == std::popcount(reference);
+    fixed_spin &= twice_spin(masks[k]) == twice_spin(reference);
+  }
+
+  std::map<std::pair<int, int>, BlockBuilder> builders;
+  for (std::size_t k = 0; k < basis.size(); k++) {
+    if (x[k] == Complex{}) {
+      continue;
+    }
+    const std::uint64_t a = masks[k] & region;
+    const std::uint64_t b = masks[k] & ~region;
+    const std::pair<int, int> key{
+        fixed_particles ? std::popcount(a) : 0,
+        fixed_particles && fixed_spin ? twice_spin(a) : 0};
+    BlockBuilder& builder = builders[key];
+    const auto row = builder.rows.try_emplace(a, builder.rows.size());
+    const auto column = builder.columns.try_emplace(b, builder.columns.size());
+    builder.entry_rows.push_back(row.first->second);
+    builder.entry_columns.push_back(column.first->second);
+    const Complex value = scale * x[k];
+    builder.entry_values.push_back(reorder_parity(a, b) ? -value : value);
+  }
+
+  EntanglementSpectrum result;
+  for (auto& [key, builder] : builders) {
+    SchmidtBlock& block = result.blocks.emplace_back();
+    block.particles = key.first;
+    block.spin = key.second;
+    const std::size_t rows = builder.rows.size();
+    const std::size_t columns = builder.columns.size();
+    block.region_a.resize(rows);
+    for (const auto& [mask, index] : builder.rows) {
+      block.region_a[index] = mask;
+    }
+    block.region_b.resize(columns);
+    for (const auto& [mask, index] : builder.columns) {
+      block.region_b[index] = mask;
+    }
+    block.matrix.assign(rows * columns, Complex{});
+    for (std::size_t e = 0; e < builder.entry_values.size(); e++) {
+      block.matrix[builder.entry_rows[e] + builder.entry_columns[e] * rows] =
+          builder.entry_values[e];
+    }
+    builder = {};
+
+    // The nonzero eigenvalues of psi psi^dagger and psi^dagger psi agree;
+    // the latter is the conjugate of psi^T (psi^T)^dagger.
+    if (rows <= columns) {
+      block.values = gram_eigenvalues(block.matrix, rows, columns);
+    } else {
+      ComplexVector transpose(rows * columns);
+      for (std::size_t j = 0; j < columns; j++) {
+        for (std::size_t i = 0; i < rows; i++) {
+          transpose[j + i * columns] = block.matrix[i + j * rows];
+        }
+      }
+      block.values = gram_eigenvalues(transpose, columns, rows);
+      block.values.resize(rows, 0.0);
+    }
+  }
+  return result;
+}
@@ -0,0 +1,57 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "LinearAlgebra.h"
+#include "StateVector.h"
+
+// Block of the Schmidt decomposition of a state between a region A of
+// orbitals and its complement B, with fixed particle number and spin of A.
+struct SchmidtBlock {
+  // Particles in A, or zero if the state has no definite particle number.
+  int particles = 0;
+  // Twice the S^z of A, or zero if the state has no definite S^z.
+  int spin = 0;
+  // Occupation masks of the configurations of A and of B in the block.
+  std::vector<std::uint64_t> region_a;
+  std::vector<std::uint64_t> region_b;
+  // The normalised state as the region_a.size() x region_b.size() matrix
+  // psi(a, b), column-major, with |psi> = sum_ab psi(a, b) |a> |b> and
+  // |a> |b> the A creation operators followed by the B ones on the vacuum.
+  ComplexVector matrix;
+  // Eigenvalues of rho_A in the block, i.e. the squared Schmidt values, in
+  // decreasing order.
+  std::vector<double> values;
+};
+
+struct EntanglementSpectrum {
+  std::vector<SchmidtBlock> blocks;
+
+  // All the eigenvalues of rho_A, in decreasing order.
+  std::vector<double> values() const;
+
+  // -tr rho_A ln rho_A.
+  double entropy() const;
+
+  // ln(tr rho_A^alpha) / (1 - alpha), for alpha != 1.
+  double renyi_entropy(double alpha) const;
+};
+
+// Entanglement between the orbitals in `orbitals` and the rest, for a state
+// in a fermionic basis.
+//
+// Every basis state c^dagger_{s_1} ... c^dagger_{s_n} |0> is reordered into
+// the creation operators of A followed by those of B, the sign being the
+// parity of the number of B operators moved past A ones. If all the
+// components of the normalised state larger than `blocking_threshold` have
+// the same particle number, and the same S^z, rho_A is taken to be block
+// diagonal in those of A, and the blocks are diagonalised separately as the
+// smaller of psi psi^dagger and psi^dagger psi.
+EntanglementSpectrum entanglement_spectrum(
+    const StateVector& state, const std::vector<std::size_t>& orbitals,
+    double blocking_threshold = 1e-10);
@@ -4,10 +4,12 @@
 #include "FermionicBasis.h"
 
 void FermionicBasis::generate_combinations(
-    BasisElement& current, size_t first_orbital, size_t depth,
-    size_t max_depth) {
-  if (depth == max_depth && m_basis_filter->filter(current)) {
-    m_basis_map.insert(current);
+    std::vector<BasisElement>& out, BasisElement& current, size_t first_orbital,
+    size_t depth, size_t max_depth) const {
+  if (depth == max_depth) {
+    if (m_basis_filter->filter(current)) {
+      out.push_back(current);
+    }
     return;
   }
 
@@ -19,9 +21,22 @@ void FermionicBasis::generate_combinations(
            (current.back().orbital() == i && spin > current.back().spin()))) {
         current.push_back(Operator(
             Operator::Type::Creation, Operator::Statistics::Fermion, spin, i));
-        generate_combinations(current, i, depth + 1, max_depth);
+        generate_combinations(out, current, i, depth + 1, max_depth);
         current.pop_back();
       }
     }
   }
 }
+
+std::vector<Operator> FermionicBasis::first_operators() const {
+  std::vector<Operator> result;
+  result.reserve(2 * m_orbitals);
+  for (size_t i = 0; i < m_orbitals; i++) {
+    for (int spin_index = 0; spin_index < 2; ++spin_index) {
+      result.push_back(Operator(
+          Operator::Type::Creation, Operator::Statistics::Fermion,
+          static_cast<Operator::Spin>(spin_index), i));
+    }
+  }
+  return result;
+}
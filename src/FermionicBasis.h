@@ -29,7 +29,11 @@ class FermionicBasis final : public Basis {
     generate_basis();
   }
 
-  void generate_combinations(BasisElement &, size_t, size_t, size_t) override;
+  void generate_combinations(
+      std::vector<BasisElement> &, BasisElement &, size_t, size_t,
+      size_t) const override;
+
+  std::vector<Operator> first_operators() const override;
 
  private:
   bool m_allow_double_occupancy;
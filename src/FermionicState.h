@@ -0,0 +1,79 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+
+#include "Basis.h"
+#include "Operator.h"
+
+// Bitmask representation of fermionic basis states. Slot 2 * orbital + spin
+// is set when that spin-orbital is occupied, and the state is
+// c^dagger_{s_1} ... c^dagger_{s_n} |0> with ascending slots, as generated by
+// FermionicBasis.
+
+inline std::uint8_t fermion_slot(const Operator& op) {
+  return static_cast<std::uint8_t>(
+      2 * op.orbital() + static_cast<std::size_t>(op.spin()));
+}
+
+inline std::uint64_t slot_bit(std::size_t slot) {
+  return std::uint64_t{1} << slot;
+}
+
+// Removes the fermion in `slot`, flipping `parity` once for every occupied
+// slot before it. Returns false if the slot is empty.
+inline bool annihilate_slot(
+    std::uint64_t& mask, std::size_t slot, bool& parity) {
+  if ((mask & slot_bit(slot)) == 0) {
+    return false;
+  }
+  mask ^= slot_bit(slot);
+  parity ^= (std::popcount(mask & (slot_bit(slot) - 1)) & 1) != 0;
+  return true;
+}
+
+// Adds a fermion to `slot`. Returns false if the slot is already occupied.
+inline bool create_slot(std::uint64_t& mask, std::size_t slot, bool& parity) {
+  if ((mask & slot_bit(slot)) != 0) {
+    return false;
+  }
+  parity ^= (std::popcount(mask & (slot_bit(slot) - 1)) & 1) != 0;
+  mask |= slot_bit(slot);
+  return true;
+}
+
+// Whether `element` is a product of fermionic creation operators in strictly
+// ascending slot order, i.e. the form the bitmask representation maps back to.
+inline bool is_fermionic_state(const BasisElement& element) {
+  for (std::size_t k = 0; k < element.size(); k++) {
+    const Operator& op = element[k];
+    if (!op.is_fermion() || op.type() != Operator::Type::Creation ||
+        (k > 0 && fermion_slot(element[k - 1]) >= fermion_slot(op))) {
+      return false;
+    }
+  }
+  return true;
+}
+
+inline std::uint64_t occupation_mask(const BasisElement& element) {
+  std::uint64_t mask = 0;
+  for (const Operator& op : element) {
+    mask |= slot_bit(fermion_slot(op));
+  }
+  return mask;
+}
+
+// The basis element with occupation `mask`, written into `element`.
+inline void fermionic_state(std::uint64_t mask, BasisElement& element) {
+  element.clear();
+  for (; mask != 0; mask &= mask - 1) {
+    const auto slot = static_cast<std::size_t>(std::countr_zero(mask));
+    element.push_back(Operator(
+        Operator::Type::Creation, Operator::Statistics::Fermion,
+        static_cast<Operator::Spin>(slot % 2), slot / 2));
+  }
+}
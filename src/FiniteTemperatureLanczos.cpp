@@ -0,0 +1,103 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "FiniteTemperatureLanczos.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+
+#include "Assert.h"
+#include "GreenFunction.h"
+
+namespace {
+
+// A Ritz value with its weight in the trace, and the sector it comes from.
+struct Sample {
+  double energy;
+  double weight;
+  double charge;
+};
+
+}  // namespace
+
+std::vector<Thermodynamics> finite_temperature_lanczos(
+    const std::vector<ThermodynamicSector>& sectors,
+    const std::vector<double>& temperatures,
+    const FiniteTemperatureLanczosOptions& options) {
+  LIBMB_ASSERT(options.random_vectors > 0 && options.lanczos_steps > 0);
+  const std::size_t runs = sectors.size() * options.random_vectors;
+  std::vector<std::vector<Sample>> samples(runs);
+
+  GreenFunctionOptions lanczos;
+  lanczos.iterations = options.lanczos_steps;
+  // Each run is serial; the runs themselves are spread over the threads.
+#pragma omp parallel for schedule(dynamic, 1)
+  for (std::size_t run = 0; run < runs; run++) {
+    const std::size_t s = run / options.random_vectors;
+    const ThermodynamicSector& sector = sectors[s];
+    const std::size_t n = sector.hamiltonian.size();
+    // Seeded per run, so that results do not depend on the scheduling.
+    std::seed_seq seed{
+        static_cast<std::uint32_t>(options.seed),
+        static_cast<std::uint32_t>(options.seed >> 32),
+        static_cast<std::uint32_t>(run)};
+    std::mt19937_64 rng(seed);
+    ComplexVector r = random_vector(n, rng);
+    scale(1.0 / norm(r), r);
+
+    const ContinuedFraction fraction =
+        continued_fraction(sector.hamiltonian, r, lanczos);
+    const TridiagonalEigen eigen = tridiagonal_eigen(fraction.a, fraction.b);
+    LIBMB_ASSERT(eigen.converged);
+    const std::size_t m = eigen.values.size();
+    const double factor = sector.multiplicity * static_cast<double>(n) /
+                          static_cast<double>(options.random_vectors);
+    for (std::size_t j = 0; j < m; j++) {
+      const double first = eigen.vectors[j * m];
+      samples[run].push_back(
+          {eigen.values[j], factor * first * first, sector.charge});
+    }
+  }
+
+  // Boltzmann factors are taken relative to the lowest Ritz value, to stay
+  // finite at low temperatures.
+  double ground = std::numeric_limits<double>::infinity();
+  for (const auto& run : samples) {
+    for (const auto& sample : run) {
+      ground = std::min(ground, sample.energy);
+    }
+  }
+
+  std::vector<Thermodynamics> result;
+  for (double temperature : temperatures) {
+    LIBMB_ASSERT(temperature > 0.0);
+    double z = 0.0;
+    double e = 0.0;
+    double e2 = 0.0;
+    double q = 0.0;
+    double q2 = 0.0;
+    for (const auto& run : samples) {
+      for (const auto& sample : run) {
+        const double shifted = sample.energy - ground;
+        const double boltzmann =
+            sample.weight * std::exp(-shifted / temperature);
+        z += boltzmann;
+        e += boltzmann * shifted;
+        e2 += boltzmann * shifted * shifted;
+        q += boltzmann * sample.charge;
+        q2 += boltzmann * sample.charge * sample.charge;
+      }
+    }
+    e /= z;
+    e2 /= z;
+    q /= z;
+    q2 /= z;
+    result.push_back(
+        {temperature, ground + e,
+         (e2 - e * e) / (temperature * temperature),
+         std::log(z) + e / temperature, (q2 - q * q) / temperature});
+  }
+  return result;
+}
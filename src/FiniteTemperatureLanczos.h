@@ -0,0 +1,54 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "LinearOperator.h"
+
+// A block of the Hamiltonian, e.g. a fixed particle number or S^z.
+struct ThermodynamicSector {
+  LinearOperator hamiltonian;
+  // Value of the conserved quantity Q of the sector, from whose fluctuations
+  // the susceptibility is obtained.
+  double charge = 0.0;
+  // Number of sectors equivalent to this one by symmetry, which are counted
+  // without being sampled.
+  double multiplicity = 1.0;
+};
+
+struct Thermodynamics {
+  double temperature;
+  // <H>.
+  double energy;
+  // (<H^2> - <H>^2) / T^2.
+  double specific_heat;
+  // ln Z + <H> / T, with Z normalised to the ground state.
+  double entropy;
+  // (<Q^2> - <Q>^2) / T.
+  double susceptibility;
+};
+
+struct FiniteTemperatureLanczosOptions {
+  // Random vectors per sector.
+  std::size_t random_vectors = 20;
+  // Lanczos steps per random vector.
+  std::size_t lanczos_steps = 60;
+  std::uint64_t seed = 0;
+};
+
+// Thermodynamics by the finite-temperature Lanczos method (k_B = 1). Traces
+// are sampled with random vectors |r>, each running a short Lanczos
+// recursion whose Ritz values e_j and weights |<psi_j|r>|^2 estimate
+//
+//   Tr f(H) ~ N / R sum_r sum_j |<psi_j|r>|^2 f(e_j)
+//
+// for all temperatures at once. The runs of all sectors and random vectors
+// are independent and executed in parallel; each keeps three vectors.
+std::vector<Thermodynamics> finite_temperature_lanczos(
+    const std::vector<ThermodynamicSector>& sectors,
+    const std::vector<double>& temperatures,
+    const FiniteTemperatureLanczosOptions& options = {});
@@ -0,0 +1,134 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "FreeFermions.h"
+
+#include <bit>
+#include <functional>
+#include <numeric>
+#include <queue>
+#include <set>
+#include <utility>
+
+#include "Assert.h"
+#include "FermionicState.h"
+
+FreeFermions::FreeFermions(
+    const CompiledExpression& hamiltonian, std::size_t orbitals)
+    : m_slots{2 * orbitals}, m_matrix(m_slots * m_slots) {
+  LIBMB_ASSERT(hamiltonian.quadratic() && hamiltonian.hermitian());
+  for (const auto& [mask, coefficient] : hamiltonian.diagonal_terms()) {
+    if (mask == 0) {
+      m_constant += coefficient;
+      continue;
+    }
+    const auto slot = static_cast<std::size_t>(std::countr_zero(mask));
+    LIBMB_ASSERT(slot < m_slots);
+    m_matrix[slot + slot * m_slots] += coefficient;
+  }
+  for (const auto& [to, from, coefficient] : hamiltonian.hopping_terms()) {
+    LIBMB_ASSERT(to < m_slots && from < m_slots);
+    m_matrix[to + from * m_slots] += coefficient;
+  }
+  m_modes = hermitian_eigen(m_matrix, m_slots);
+  LIBMB_ASSERT(m_modes.converged);
+}
+
+std::vector<std::size_t> FreeFermions::lowest_modes(
+    std::size_t particles) const {
+  LIBMB_ASSERT(particles <= m_slots);
+  std::vector<std::size_t> result(particles);
+  std::iota(result.begin(), result.end(), std::size_t{0});
+  return result;
+}
+
+double FreeFermions::energy(const std::vector<std::size_t>& occupied) const {
+  double result = m_constant.real();
+  for (std::size_t n : occupied) {
+    result += m_modes.values[n];
+  }
+  return result;
+}
+
+double FreeFermions::ground_state_energy(std::size_t particles) const {
+  return energy(lowest_modes(particles));
+}
+
+std::vector<double> FreeFermions::lowest_energies(
+    std::size_t particles, std::size_t count) const {
+  // Best-first search over the occupied modes, stored ascending. Moving one
+  // fermion to the next mode up never lowers the energy, and every
+  // configuration is reached that way from the lowest one.
+  using Configuration = std::pair<double, std::vector<std::size_t>>;
+  std::priority_queue<
+      Configuration, std::vector<Configuration>, std::greater<>>
+      queue;
+  std::set<std::vector<std::size_t>> seen;
+  const std::vector<std::size_t> lowest = lowest_modes(particles);
+  queue.push({energy(lowest), lowest});
+  seen.insert(lowest);
+
+  std::vector<double> result;
+  while (result.size() < count && !queue.empty()) {
+    const auto [value, occupied] = queue.top();
+    queue.pop();
+    result.push_back(value);
+    for (std::size_t a = 0; a < particles; a++) {
+      const std::size_t next = occupied[a] + 1;
+      if (next == m_slots || (a + 1 < particles && occupied[a + 1] == next)) {
+        continue;
+      }
+      std::vector<std::size_t> moved = occupied;
+      moved[a] = next;
+      if (seen.insert(moved).second) {
+        queue.push({energy(moved), std::move(moved)});
+      }
+    }
+  }
+  return result;
+}
+
+ComplexVector FreeFermions::correlation(
+    const std::vector<std::size_t>& occupied) const {
+  const ComplexVector& u = m_modes.vectors;
+  ComplexVector result(m_slots * m_slots);
+  for (std::size_t j = 0; j < m_slots; j++) {
+    for (std::size_t i = 0; i < m_slots; i++) {
+      Complex sum{};
+      for (std::size_t n : occupied) {
+        sum += std::conj(u[i + n * m_slots]) * u[j + n * m_slots];
+      }
+      result[i + j * m_slots] = sum;
+    }
+  }
+  return result;
+}
+
+StateVector FreeFermions::slater_determinant(
+    const Basis& basis, const std::vector<std::size_t>& occupied) const {
+  const std::size_t particles = occupied.size();
+  const std::size_t size = basis.size();
+  StateVector result(basis);
+#pragma omp parallel
+  {
+    ComplexVector minor(particles * particles);
+#pragma omp for schedule(dynamic, 64)
+    for (std::size_t k = 0; k < size; k++) {
+      LIBMB_ASSERT(is_fermionic_state(basis.elements()[k]));
+      std::uint64_t mask = occupation_mask(basis.elements()[k]);
+      if (static_cast<std::size_t>(std::popcount(mask)) != particles) {
+        continue;
+      }
+      for (std::size_t a = 0; mask != 0; a++, mask &= mask - 1) {
+        const auto slot = static_cast<std::size_t>(std::countr_zero(mask));
+        LIBMB_ASSERT(slot < m_slots);
+        for (std::size_t b = 0; b < particles; b++) {
+          minor[a + b * particles] =
+              m_modes.vectors[slot + occupied[b] * m_slots];
+        }
+      }
+      result[k] = determinant(minor, particles);
+    }
+  }
+  return result;
+}
@@ -0,0 +1,83 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "Basis.h"
+#include "CompiledExpression.h"
+#include "LinearAlgebra.h"
+#include "Model.h"
+#include "StateVector.h"
+
+// A quadratic Hamiltonian H = sum_ij h_ij c^dagger_i c_j + constant, solved
+// through its single-particle matrix h, indexed by spin-orbital
+// 2 * orbital + spin. Its many-body eigenstates are the Slater determinants
+// d^dagger_{n_1} ... d^dagger_{n_N} |0> of the modes
+// d^dagger_n = sum_i U_in c^dagger_i, h U = U diag(energies), so energies and
+// correlators cost a diagonalisation of h instead of one of the many-body
+// matrix, whose dimension is exponential in the number of orbitals.
+class FreeFermions {
+ public:
+  // `hamiltonian` must be Hermitian and quadratic(), acting on the first
+  // `orbitals` orbitals.
+  FreeFermions(const CompiledExpression& hamiltonian, std::size_t orbitals);
+
+  FreeFermions(const Model& model, std::size_t orbitals)
+      : FreeFermions(model.compiled_hamiltonian(), orbitals) {}
+
+  // Number of spin-orbitals.
+  std::size_t slots() const { return m_slots; }
+
+  // h, column-major.
+  const ComplexVector& single_particle_matrix() const { return m_matrix; }
+
+  Complex constant() const { return m_constant; }
+
+  // Ascending single-particle energies.
+  const std::vector<double>& energies() const { return m_modes.values; }
+
+  // U, whose column n is the mode with energy energies()[n].
+  const ComplexVector& modes() const { return m_modes.vectors; }
+
+  // Energy of the Slater determinant of the modes in `occupied`.
+  double energy(const std::vector<std::size_t>& occupied) const;
+
+  // Ground state energy with `particles` fermions, which fill the lowest
+  // modes. With a degenerate shell at the Fermi level, the ground state is
+  // any Slater determinant filling it, and the one of the lowest modes is
+  // returned by the functions below.
+  double ground_state_energy(std::size_t particles) const;
+
+  // The `count` lowest many-body energies with `particles` fermions,
+  // ascending and with multiplicity.
+  std::vector<double> lowest_energies(
+      std::size_t particles, std::size_t count) const;
+
+  // <c^dagger_i c_j> = sum_{n occupied} conj(U_in) U_jn at i + j * slots().
+  ComplexVector correlation(const std::vector<std::size_t>& occupied) const;
+
+  ComplexVector ground_state_correlation(std::size_t particles) const {
+    return correlation(lowest_modes(particles));
+  }
+
+  // The Slater determinant of the modes in `occupied` expanded in a
+  // fermionic basis; the amplitude of a basis state is the determinant of
+  // the rows of U of its occupied spin-orbitals and the occupied columns.
+  StateVector slater_determinant(
+      const Basis& basis, const std::vector<std::size_t>& occupied) const;
+
+  StateVector ground_state(const Basis& basis) const {
+    return slater_determinant(basis, lowest_modes(basis.particles()));
+  }
+
+ private:
+  std::vector<std::size_t> lowest_modes(std::size_t particles) const;
+
+  std::size_t m_slots;
+  ComplexVector m_matrix;
+  Complex m_constant{};
+  HermitianEigen m_modes;
+};
@@ -0,0 +1,57 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "GaussianState.h"
+
+#include <utility>
+
+#include "Assert.h"
+#include "FermionicState.h"
+#include "NormalOrder.h"
+
+GaussianState::GaussianState(ComplexVector correlation, std::size_t slots)
+    : m_slots{slots}, m_correlation{std::move(correlation)} {
+  LIBMB_ASSERT(m_correlation.size() == m_slots * m_slots);
+}
+
+Complex GaussianState::normal_ordered_expectation(
+    const std::vector<Operator>& operators) const {
+  std::vector<std::size_t> created;
+  std::vector<std::size_t> annihilated;
+  for (const Operator& op : operators) {
+    LIBMB_ASSERT(op.is_fermion());
+    const std::size_t slot = fermion_slot(op);
+    LIBMB_ASSERT(slot < m_slots);
+    if (op.type() == Operator::Type::Creation) {
+      LIBMB_ASSERT(annihilated.empty());
+      created.push_back(slot);
+    } else {
+      annihilated.push_back(slot);
+    }
+  }
+  const std::size_t k = created.size();
+  if (annihilated.size() != k) {
+    return {};
+  }
+  // c_{j_k} ... c_{j_1}: the annihilation operator contracted with the
+  // creation operator a places to its left is the (k - 1 - a)-th one.
+  ComplexVector contractions(k * k);
+  for (std::size_t b = 0; b < k; b++) {
+    for (std::size_t a = 0; a < k; a++) {
+      contractions[a + b * k] =
+          m_correlation[created[a] + annihilated[k - 1 - b] * m_slots];
+    }
+  }
+  return determinant(std::move(contractions), k);
+}
+
+Complex GaussianState::expectation(const Expression& expression) const {
+  Complex result{};
+  for (const auto& [operators, coefficient] :
+       NormalOrderer(expression).terms()) {
+    if (coefficient != Complex{}) {
+      result += coefficient * normal_ordered_expectation(operators);
+    }
+  }
+  return result;
+}
@@ -0,0 +1,50 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "Expression.h"
+#include "LinearAlgebra.h"
+#include "Operator.h"
+#include "Term.h"
+
+// A number-conserving fermionic Gaussian state, e.g. a Slater determinant or
+// a thermal state of a quadratic Hamiltonian, given by its correlation matrix
+// G_ij = <c^dagger_i c_j> over the spin-orbitals 2 * orbital + spin, as
+// returned by FreeFermions::correlation() or density_matrices().
+//
+// Expectation values follow from Wick's theorem: an expression is normal
+// ordered by NormalOrderer, and each of its strings
+// c^dagger_{i_1} ... c^dagger_{i_k} c_{j_k} ... c_{j_1} evaluates to the
+// determinant of the k x k matrix G_{i_a j_b}. Strings with different
+// numbers of creation and annihilation operators vanish. The cost is
+// polynomial in the length of the strings and independent of the dimension
+// of the many-body space.
+class GaussianState {
+ public:
+  // `correlation` is the slots x slots matrix G, column-major.
+  GaussianState(ComplexVector correlation, std::size_t slots);
+
+  std::size_t slots() const { return m_slots; }
+
+  const ComplexVector& correlation() const { return m_correlation; }
+
+  // <O>, for an expression in fermions only.
+  Complex expectation(const Expression& expression) const;
+
+  Complex expectation(const std::vector<Term>& terms) const {
+    return expectation(Expression(terms));
+  }
+
+  // <c^dagger_{i_1} ... c^dagger_{i_k} c_{j_k} ... c_{j_1}>, for a string
+  // with all its creation operators first.
+  Complex normal_ordered_expectation(
+      const std::vector<Operator>& operators) const;
+
+ private:
+  std::size_t m_slots;
+  ComplexVector m_correlation;
+};
@@ -4,10 +4,10 @@
 #include "GenericBasis.h"
 
 void GenericBasis::generate_combinations(
-    BasisElement& current, size_t first_orbital, size_t depth,
-    size_t max_depth) {
+    std::vector<BasisElement>& out, BasisElement& current, size_t first_orbital,
+    size_t depth, size_t max_depth) const {
   if (m_basis_filter->filter(current)) {
-    m_basis_map.insert(current);
+    out.push_back(current);
   }
 
   if (depth == max_depth) {
@@ -24,8 +24,20 @@ void GenericBasis::generate_combinations(
       current.push_back(Operator(
           Operator::Type::Creation, Operator::Statistics::Boson, spin,
           orbital_index));
-      generate_combinations(current, orbital_index, depth + 1, max_depth);
+      generate_combinations(
+          out, current, orbital_index, depth + 1, max_depth);
       current.pop_back();
     }
   }
 }
+
+std::vector<Operator> GenericBasis::first_operators() const {
+  std::vector<Operator> result;
+  result.reserve(m_orbitals);
+  for (size_t orbital_index = 0; orbital_index < m_orbitals; orbital_index++) {
+    result.push_back(Operator(
+        Operator::Type::Creation, Operator::Statistics::Boson,
+        Operator::Spin::Up, orbital_index));
+  }
+  return result;
+}
@@ -0,0 +1,74 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "GreenFunction.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+
+#include "Assert.h"
+#include "CompiledExpression.h"
+
+Complex ContinuedFraction::operator()(Complex z) const {
+  // Evaluated from the innermost level outwards.
+  Complex tail{};
+  for (std::size_t n = a.size(); n-- > 0;) {
+    const double coupling = n + 1 < a.size() ? b[n] * b[n] : 0.0;
+    tail = 1.0 / (z - a[n] - coupling * tail);
+  }
+  return weight * tail;
+}
+
+double ContinuedFraction::spectral(double omega, double eta) const {
+  return -(*this)({omega, eta}).imag() / std::numbers::pi;
+}
+
+ContinuedFraction continued_fraction(
+    const LinearOperator& hamiltonian, const ComplexVector& phi,
+    const GreenFunctionOptions& options) {
+  LIBMB_ASSERT(phi.size() == hamiltonian.size());
+  ContinuedFraction result;
+  const double phi_norm = norm(phi);
+  result.weight = phi_norm * phi_norm;
+  if (phi_norm == 0.0) {
+    return result;
+  }
+
+  ComplexVector previous(phi.size());
+  ComplexVector current = phi;
+  scale(1.0 / phi_norm, current);
+  ComplexVector next;
+  double scale_a = 0.0;
+  for (std::size_t n = 0; n < options.iterations; n++) {
+    hamiltonian.apply(current, next);
+    const double a = dot(current, next).real();
+    result.a.push_back(a);
+    scale_a = std::max(scale_a, std::abs(a));
+    axpy(-a, current, next);
+    if (n > 0) {
+      axpy(-result.b.back(), previous, next);
+    }
+    const double b = norm(next);
+    if (n + 1 == options.iterations ||
+        b <= options.tolerance * std::max(1.0, scale_a)) {
+      break;
+    }
+    result.b.push_back(b);
+    scale(1.0 / b, next);
+    std::swap(previous, current);
+    std::swap(current, next);
+  }
+  return result;
+}
+
+ContinuedFraction dynamical_correlation(
+    const LinearOperator& hamiltonian, const Expression& op,
+    const Basis& basis, const ComplexVector& psi, const Basis& target_basis,
+    const GreenFunctionOptions& options) {
+  LIBMB_ASSERT(psi.size() == basis.size());
+  LIBMB_ASSERT(hamiltonian.size() == target_basis.size());
+  ComplexVector phi(target_basis.size());
+  CompiledExpression(op).apply(basis, psi, target_basis, phi);
+  return continued_fraction(hamiltonian, phi, options);
+}
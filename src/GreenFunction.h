@@ -0,0 +1,57 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include <cstddef>
+#include <vector>
+
+#include "Basis.h"
+#include "Expression.h"
+#include "LinearOperator.h"
+
+// <phi|(z - H)^-1|phi> written as the continued fraction
+//
+//   weight / (z - a_0 - b_0^2 / (z - a_1 - b_1^2 / (z - a_2 - ...)))
+//
+// whose coefficients are those of the Lanczos recursion of H started from
+// |phi>, with weight = <phi|phi>. Once they are known, evaluating it at a
+// frequency costs O(iterations).
+struct ContinuedFraction {
+  double weight = 0.0;
+  std::vector<double> a;
+  // b[n] couples Lanczos vectors n and n + 1; one element less than a.
+  std::vector<double> b;
+
+  Complex operator()(Complex z) const;
+
+  // -Im G(omega + i eta) / pi, with G = (*this).
+  double spectral(double omega, double eta) const;
+};
+
+struct GreenFunctionOptions {
+  std::size_t iterations = 200;
+  // The recursion stops early when b_n falls below this, relative to the
+  // largest |a_n|, as the Krylov space is then invariant.
+  double tolerance = 1e-12;
+};
+
+// Continued fraction of <phi|(z - H)^-1|phi> for |phi>, by Lanczos without
+// reorthogonalisation, which keeps only three vectors. Loss of
+// orthogonality only duplicates converged poles, whose weights stay
+// correct.
+ContinuedFraction continued_fraction(
+    const LinearOperator& hamiltonian, const ComplexVector& phi,
+    const GreenFunctionOptions& options = {});
+
+// Dynamical correlation <psi|O^dagger (z - H)^-1 O|psi> of the state psi in
+// `basis`, with O|psi> expressed in `target_basis` (the sector O leads to),
+// on which `hamiltonian` acts. With psi the ground state of energy E_0,
+// O = c^dagger and z = omega + E_0 + i eta this is the electron addition
+// part of the single-particle Green's function. The removal part is
+// -F(E_0 - omega - i eta) for the fraction F of O = c, and dynamic structure
+// factors follow from O = S^z_q.
+ContinuedFraction dynamical_correlation(
+    const LinearOperator& hamiltonian, const Expression& op,
+    const Basis& basis, const ComplexVector& psi, const Basis& target_basis,
+    const GreenFunctionOptions& options = {});
@@ -0,0 +1,105 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include <omp.h>
+
+#include <complex>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "Assert.h"
+#include "CsrMatrix.h"
+
+// A Hermitian matrix stored as its upper triangle, diagonal included. Each
+// stored off-diagonal element a_ij also stands for a_ji = conj(a_ij), which
+// halves the memory of the matrix and the traffic of a product with it.
+template <typename T>
+class HermitianCsrMatrix {
+ public:
+  HermitianCsrMatrix() = default;
+
+  explicit HermitianCsrMatrix(CsrMatrix<T> upper) : m_upper{std::move(upper)} {
+    LIBMB_ASSERT(m_upper.rows() == m_upper.cols());
+  }
+
+  std::size_t size() const { return m_upper.rows(); }
+
+  // Number of stored elements.
+  std::size_t nonzeros() const { return m_upper.nonzeros(); }
+
+  const CsrMatrix<T>& upper() const { return m_upper; }
+
+  T operator()(std::size_t i, std::size_t j) const {
+    return i <= j ? m_upper(i, j) : std::conj(m_upper(j, i));
+  }
+
+  // Per-thread accumulators of multiply(). They are kept zeroed between
+  // products, so a workspace reused across products, as in a Lanczos run,
+  // allocates and clears them only once.
+  class Workspace {
+   private:
+    friend class HermitianCsrMatrix;
+    std::vector<std::vector<T>> m_buffers;
+  };
+
+  // y = A x.
+  template <typename Vec>
+  void multiply(const Vec& x, Vec& y) const {
+    Workspace workspace;
+    multiply(x, y, workspace);
+  }
+
+  // y = A x. A stored element of row r contributes to both y[r] and
+  // y[column]; the latter is accumulated in a buffer per thread so that rows
+  // can be processed concurrently. The buffers are summed into y and reset
+  // in the same pass.
+  template <typename Vec>
+  void multiply(const Vec& x, Vec& y, Workspace& workspace) const {
+    const std::size_t n = size();
+    const auto& offsets = m_upper.row_offsets();
+    const auto& columns = m_upper.columns();
+    const auto& values = m_upper.values();
+    auto& buffers = workspace.m_buffers;
+
+#pragma omp parallel
+    {
+#pragma omp single
+      buffers.resize(static_cast<std::size_t>(omp_get_num_threads()));
+
+      std::vector<T>& buffer =
+          buffers[static_cast<std::size_t>(omp_get_thread_num())];
+      if (buffer.size() != n) {
+        buffer.assign(n, T{});
+      }
+
+#pragma omp for schedule(dynamic, 256)
+      for (std::size_t r = 0; r < n; r++) {
+        T sum{};
+        for (std::size_t k = offsets[r]; k < offsets[r + 1]; k++) {
+          const std::size_t c = columns[k];
+          sum += values[k] * x[c];
+          if (c != r) {
+            buffer[c] += std::conj(values[k]) * x[r];
+          }
+        }
+        buffer[r] += sum;
+      }
+
+#pragma omp for schedule(static)
+      for (std::size_t r = 0; r < n; r++) {
+        T sum{};
+        for (auto& partial : buffers) {
+          sum += partial[r];
+          partial[r] = T{};
+        }
+        y[r] = sum;
+      }
+    }
+  }
+
+ private:
+  CsrMatrix<T> m_upper;
+};
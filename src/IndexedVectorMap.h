@@ -8,6 +8,8 @@
 #include <unordered_map>
 #include <vector>
 
+#include "ParallelSort.h"
+
 template <class T>
 class IndexedVectorMap {
  public:
@@ -30,6 +32,11 @@ class IndexedVectorMap {
     m_index_map[value] = m_elements.size() - 1;
   }
 
+  void reserve(std::size_t n) {
+    m_elements.reserve(n);
+    m_index_map.reserve(n);
+  }
+
   const T& operator[](std::size_t idx) const { return m_elements[idx]; }
 
   std::size_t index(const T& value) const { return m_index_map.at(value); }
@@ -42,9 +49,13 @@ class IndexedVectorMap {
 
   template <class CompareFunction>
   void sort(CompareFunction comp) {
-    std::sort(m_elements.begin(), m_elements.end(), comp);
-    for (std::size_t i = 0; i < m_elements.size(); i++) {
-      m_index_map[m_elements[i]] = i;
+    parallel_sort(m_elements.begin(), m_elements.end(), comp);
+    // Only the mapped values change, so the entries can be updated
+    // concurrently without modifying the structure of the hash map.
+    const std::size_t size = m_elements.size();
+#pragma omp parallel for schedule(static)
+    for (std::size_t i = 0; i < size; i++) {
+      m_index_map.find(m_elements[i])->second = i;
     }
   }
 };
@@ -0,0 +1,185 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "KernelPolynomial.h"
+
+#include <algorithm>
+#include <cmath>
+#include <numbers>
+#include <random>
+#include <utility>
+
+#include "Assert.h"
+
+namespace {
+
+// Moments mu_n = Re <v_j|T_n(x)|v_j>, summed over the k vectors of the block
+// v, for n < moments. With t_n = T_n(x) v, the products
+//
+//   mu_{2n} = 2 <t_n|t_n> - mu_0,  mu_{2n+1} = 2 <t_{n+1}|t_n> - mu_1
+//
+// give two moments per application of the operator.
+std::vector<double> chebyshev_moments(
+    const LinearOperator& op, const ComplexVector& v, std::size_t k,
+    SpectralBounds bounds, std::size_t moments) {
+  LIBMB_ASSERT(moments >= 2 && bounds.upper > bounds.lower);
+  const double center = (bounds.upper + bounds.lower) / 2.0;
+  const double half_width = (bounds.upper - bounds.lower) / 2.0;
+
+  // y = (A - center) x / half_width.
+  auto rescaled = [&](const ComplexVector& x, ComplexVector& y) {
+    op.apply_block(x, y, k);
+    axpy(-center, x, y);
+    scale(1.0 / half_width, y);
+  };
+  auto trace = [&](const ComplexVector& x, const ComplexVector& y) {
+    const ComplexVector gram = block_inner(x, k, y, k);
+    double sum = 0.0;
+    for (std::size_t j = 0; j < k; j++) {
+      sum += gram[j + j * k].real();
+    }
+    return sum;
+  };
+
+  std::vector<double> mu(moments, 0.0);
+  ComplexVector previous = v;
+  ComplexVector current;
+  rescaled(previous, current);
+  mu[0] = trace(previous, previous);
+  mu[1] = trace(previous, current);
+  ComplexVector next;
+  for (std::size_t n = 1; 2 * n < moments; n++) {
+    // t_n = current, t_{n-1} = previous.
+    mu[2 * n] = 2.0 * trace(current, current) - mu[0];
+    if (2 * n + 1 >= moments) {
+      break;
+    }
+    rescaled(current, next);
+    scale(2.0, next);
+    axpy(-1.0, previous, next);
+    mu[2 * n + 1] = 2.0 * trace(next, current) - mu[1];
+    std::swap(previous, current);
+    std::swap(current, next);
+  }
+  return mu;
+}
+
+}  // namespace
+
+SpectralBounds spectral_bounds(
+    const LinearOperator& op, std::size_t iterations, double margin,
+    std::uint64_t seed) {
+  std::mt19937_64 rng(seed);
+  ComplexVector current = random_vector(op.size(), rng);
+  scale(1.0 / norm(current), current);
+  ComplexVector previous(op.size());
+  ComplexVector next;
+  std::vector<double> alpha;
+  std::vector<double> beta;
+  for (std::size_t j = 0; j < std::min(iterations, op.size()); j++) {
+    op.apply(current, next);
+    alpha.push_back(dot(current, next).real());
+    axpy(-alpha.back(), current, next);
+    if (j > 0) {
+      axpy(-beta.back(), previous, next);
+    }
+    const double b = norm(next);
+    if (b <= 1e-12 * std::max(1.0, std::abs(alpha.back())) ||
+        j + 1 == std::min(iterations, op.size())) {
+      break;
+    }
+    beta.push_back(b);
+    scale(1.0 / b, next);
+    std::swap(previous, current);
+    std::swap(current, next);
+  }
+  const TridiagonalEigen eigen = tridiagonal_eigen(alpha, beta, false);
+  LIBMB_ASSERT(eigen.converged);
+  const double lower = eigen.values.front();
+  const double upper = eigen.values.back();
+  const double padding = margin * std::max(upper - lower, 1.0);
+  return {lower - padding, upper + padding};
+}
+
+ChebyshevExpansion::ChebyshevExpansion(
+    SpectralBounds bounds, std::vector<double> moments)
+    : m_center{(bounds.upper + bounds.lower) / 2.0},
+      m_half_width{(bounds.upper - bounds.lower) / 2.0},
+      m_moments{std::move(moments)} {
+  const std::size_t n_moments = m_moments.size();
+  const double q = std::numbers::pi / static_cast<double>(n_moments + 1);
+  m_damped.resize(n_moments);
+  for (std::size_t n = 0; n < n_moments; n++) {
+    const double dn = static_cast<double>(n);
+    const double jackson =
+        (static_cast<double>(n_moments) - dn + 1.0) * std::cos(q * dn) +
+        std::sin(q * dn) / std::tan(q);
+    m_damped[n] = jackson / static_cast<double>(n_moments + 1) * m_moments[n];
+  }
+}
+
+double ChebyshevExpansion::operator()(double omega) const {
+  const double x = (omega - m_center) / m_half_width;
+  if (std::abs(x) >= 1.0) {
+    return 0.0;
+  }
+  // sum_n g_n mu_n T_n(x) by the Chebyshev recurrence.
+  double previous = 1.0;
+  double current = x;
+  double sum = m_damped[0];
+  for (std::size_t n = 1; n < m_damped.size(); n++) {
+    sum += 2.0 * m_damped[n] * current;
+    const double next = 2.0 * x * current - previous;
+    previous = current;
+    current = next;
+  }
+  return sum / (std::numbers::pi * std::sqrt(1.0 - x * x) * m_half_width);
+}
+
+std::vector<double> ChebyshevExpansion::evaluate(
+    const std::vector<double>& omegas) const {
+  std::vector<double> result(omegas.size());
+  const std::size_t size = omegas.size();
+#pragma omp parallel for schedule(static)
+  for (std::size_t i = 0; i < size; i++) {
+    result[i] = (*this)(omegas[i]);
+  }
+  return result;
+}
+
+ChebyshevExpansion kpm_spectral_function(
+    const LinearOperator& op, const ComplexVector& phi, SpectralBounds bounds,
+    const KernelPolynomialOptions& options) {
+  LIBMB_ASSERT(phi.size() == op.size());
+  return {bounds, chebyshev_moments(op, phi, 1, bounds, options.moments)};
+}
+
+ChebyshevExpansion kpm_density_of_states(
+    const LinearOperator& op, SpectralBounds bounds,
+    const KernelPolynomialOptions& options) {
+  const std::size_t n = op.size();
+  LIBMB_ASSERT(options.random_vectors > 0 && options.block_size > 0);
+  std::mt19937_64 rng(options.seed);
+  std::uniform_real_distribution<double> angle(0.0, 2.0 * std::numbers::pi);
+  std::vector<double> mu(options.moments, 0.0);
+  for (std::size_t first = 0; first < options.random_vectors;
+       first += options.block_size) {
+    const std::size_t k =
+        std::min(options.block_size, options.random_vectors - first);
+    ComplexVector block(n * k);
+    for (auto& value : block) {
+      value = std::polar(1.0, angle(rng));
+    }
+    const std::vector<double> partial =
+        chebyshev_moments(op, block, k, bounds, options.moments);
+    for (std::size_t m = 0; m < mu.size(); m++) {
+      mu[m] += partial[m];
+    }
+  }
+  const double normalisation =
+      static_cast<double>(n) * static_cast<double>(options.random_vectors);
+  for (auto& value : mu) {
+    value /= normalisation;
+  }
+  return {bounds, std::move(mu)};
+}
@@ -0,0 +1,70 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "LinearOperator.h"
+
+// Interval containing the spectrum of an operator.
+struct SpectralBounds {
+  double lower;
+  double upper;
+};
+
+// Bounds of the spectrum of the Hermitian operator `op` from the extreme
+// Ritz values of a short Lanczos run. Those approach the spectrum from the
+// inside, so the interval is widened by `margin` times its width, which the
+// Chebyshev expansion needs anyway to stay away from +-1.
+SpectralBounds spectral_bounds(
+    const LinearOperator& op, std::size_t iterations = 40,
+    double margin = 0.05, std::uint64_t seed = 0);
+
+// A density rho(omega) expanded in Chebyshev polynomials of the rescaled
+// variable x = (omega - center) / half_width, damped with the Jackson kernel
+// to suppress Gibbs oscillations. Its resolution is about
+// pi * half_width / moments.
+class ChebyshevExpansion {
+ public:
+  ChebyshevExpansion(SpectralBounds bounds, std::vector<double> moments);
+
+  const std::vector<double>& moments() const { return m_moments; }
+
+  // The density at omega, zero outside of the bounds.
+  double operator()(double omega) const;
+
+  std::vector<double> evaluate(const std::vector<double>& omegas) const;
+
+ private:
+  double m_center;
+  double m_half_width;
+  std::vector<double> m_moments;
+  // Jackson kernel times the moments.
+  std::vector<double> m_damped;
+};
+
+struct KernelPolynomialOptions {
+  std::size_t moments = 256;
+  // Random vectors used for stochastic traces.
+  std::size_t random_vectors = 16;
+  // Random vectors propagated together, as a block.
+  std::size_t block_size = 4;
+  std::uint64_t seed = 0;
+};
+
+// Spectral function <phi|delta(omega - H)|phi>, which integrates to
+// <phi|phi>. Only three vectors are kept, and every product gives two
+// moments.
+ChebyshevExpansion kpm_spectral_function(
+    const LinearOperator& op, const ComplexVector& phi, SpectralBounds bounds,
+    const KernelPolynomialOptions& options = {});
+
+// Density of states Tr delta(omega - H) / N, normalised to one, from a
+// stochastic trace over random phase vectors, whose error decreases as
+// 1 / sqrt(N * random vectors).
+ChebyshevExpansion kpm_density_of_states(
+    const LinearOperator& op, SpectralBounds bounds,
+    const KernelPolynomialOptions& options = {});
@@ -0,0 +1,466 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "LinearAlgebra.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <utility>
+
+#include "Assert.h"
+
+namespace {
+
+// Diagonalises the symmetric tridiagonal matrix (d, e), with e[i] coupling i
+// and i + 1, by implicit QL with Wilkinson shifts. The rotations are applied
+// to the columns of the n x n matrix z when given. On return d holds the
+// (unsorted) eigenvalues. Returns false, leaving d and z partially
+// diagonalised, if an eigenvalue needs more than max_iterations sweeps.
+template <typename T>
+bool tridiagonal_ql(
+    std::vector<double>& d, std::vector<double>& e, std::vector<T>* z,
+    std::size_t max_iterations) {
+  const std::size_t n = d.size();
+  const double eps = std::numeric_limits<double>::epsilon();
+  e.resize(n, 0.0);
+  for (std::size_t l = 0; l < n; l++) {
+    std::size_t iterations = 0;
+    while (true) {
+      std::size_t m = l;
+      for (; m + 1 < n; m++) {
+        const double dd = std::abs(d[m]) + std::abs(d[m + 1]);
+        if (std::abs(e[m]) <= eps * dd) {
+          break;
+        }
+      }
+      if (m == l) {
+        break;
+      }
+      if (iterations == max_iterations) {
+        return false;
+      }
+      iterations++;
+
+      double g = (d[l + 1] - d[l]) / (2.0 * e[l]);
+      double r = std::hypot(g, 1.0);
+      g = d[m] - d[l] + e[l] / (g + std::copysign(r, g));
+      double s = 1.0;
+      double c = 1.0;
+      double p = 0.0;
+      bool underflow = false;
+      for (std::size_t i = m; i-- > l;) {
+        const double f = s * e[i];
+        const double b = c * e[i];
+        r = std::hypot(f, g);
+        e[i + 1] = r;
+        if (r == 0.0) {
+          d[i + 1] -= p;
+          e[m] = 0.0;
+          underflow = true;
+          break;
+        }
+        s = f / r;
+        c = g / r;
+        g = d[i + 1] - p;
+        r = (d[i] - g) * s + 2.0 * c * b;
+        p = s * r;
+        d[i + 1] = g + p;
+        g = c * r - b;
+        if (z) {
+          T* zi = z->data() + i * n;
+          T* zj = z->data() + (i + 1) * n;
+          for (std::size_t k = 0; k < n; k++) {
+            const T t = zj[k];
+            zj[k] = s * zi[k] + c * t;
+            zi[k] = c * zi[k] - s * t;
+          }
+        }
+      }
+      if (underflow) {
+        continue;
+      }
+      d[l] -= p;
+      e[l] = g;
+      e[m] = 0.0;
+    }
+  }
+  return true;
+}
+
+// Sorts the eigenvalues in ascending order, permuting the columns of the
+// eigenvector matrix along.
+template <typename T>
+void sort_eigenpairs(std::vector<double>& values, std::vector<T>& vectors) {
+  const std::size_t n = values.size();
+  std::vector<std::size_t> order(n);
+  std::iota(order.begin(), order.end(), std::size_t{0});
+  std::stable_sort(
+      order.begin(), order.end(),
+      [&](std::size_t a, std::size_t b) { return values[a] < values[b]; });
+  std::vector<double> sorted_values(n);
+  std::vector<T> sorted_vectors(vectors.empty() ? 0 : n * n);
+  for (std::size_t j = 0; j < n; j++) {
+    sorted_values[j] = values[order[j]];
+    if (!vectors.empty()) {
+      std::copy_n(
+          vectors.begin() + static_cast<std::ptrdiff_t>(order[j] * n), n,
+          sorted_vectors.begin() + static_cast<std::ptrdiff_t>(j * n));
+    }
+  }
+  values = std::move(sorted_values);
+  vectors = std::move(sorted_vectors);
+}
+
+}  // namespace
+
+Complex dot(const ComplexVector& x, const ComplexVector& y) {
+  LIBMB_ASSERT(x.size() == y.size());
+  const std::size_t size = x.size();
+  double real = 0.0;
+  double imag = 0.0;
+#pragma omp parallel for schedule(static) reduction(+ : real, imag)
+  for (std::size_t i = 0; i < size; i++) {
+    const Complex value = std::conj(x[i]) * y[i];
+    real += value.real();
+    imag += value.imag();
+  }
+  return {real, imag};
+}
+
+double norm(const ComplexVector& x) {
+  const std::size_t size = x.size();
+  double sum = 0.0;
+#pragma omp parallel for schedule(static) reduction(+ : sum)
+  for (std::size_t i = 0; i < size; i++) {
+    sum += std::norm(x[i]);
+  }
+  return std::sqrt(sum);
+}
+
+void axpy(Complex a, const ComplexVector& x, ComplexVector& y) {
+  LIBMB_ASSERT(x.size() == y.size());
+  const std::size_t size = x.size();
+#pragma omp parallel for schedule(static)
+  for (std::size_t i = 0; i < size; i++) {
+    y[i] += a * x[i];
+  }
+}
+
+void scale(Complex a, ComplexVector& x) {
+  const std::size_t size = x.size();
+#pragma omp parallel for schedule(static)
+  for (std::size_t i = 0; i < size; i++) {
+    x[i] *= a;
+  }
+}
+
+ComplexVector block_inner(
+    const ComplexVector& v, std::size_t kv, const ComplexVector& w,
+    std::size_t kw) {
+  LIBMB_ASSERT(v.size() * kw == w.size() * kv);
+  const std::size_t n = kv == 0 ? 0 : v.size() / kv;
+  ComplexVector result(kv * kw);
+#pragma omp parallel
+  {
+    ComplexVector partial(kv * kw);
+#pragma omp for schedule(static)
+    for (std::size_t i = 0; i < n; i++) {
+      const Complex* vi = v.data() + i * kv;
+      const Complex* wi = w.data() + i * kw;
+      for (std::size_t b = 0; b < kw; b++) {
+        for (std::size_t a = 0; a < kv; a++) {
+          partial[a + b * kv] += std::conj(vi[a]) * wi[b];
+        }
+      }
+    }
+#pragma omp critical
+    for (std::size_t k = 0; k < result.size(); k++) {
+      result[k] += partial[k];
+    }
+  }
+  return result;
+}
+
+void block_subtract(
+    ComplexVector& w, std::size_t kw, const ComplexVector& v, std::size_t kv,
+    const ComplexVector& c) {
+  LIBMB_ASSERT(v.size() * kw == w.size() * kv && c.size() == kv * kw);
+  const std::size_t n = kv == 0 ? 0 : v.size() / kv;
+#pragma omp parallel for schedule(static)
+  for (std::size_t i = 0; i < n; i++) {
+    const Complex* vi = v.data() + i * kv;
+    Complex* wi = w.data() + i * kw;
+    for (std::size_t b = 0; b < kw; b++) {
+      Complex sum{};
+      for (std::size_t a = 0; a < kv; a++) {
+        sum += vi[a] * c[a + b * kv];
+      }
+      wi[b] -= sum;
+    }
+  }
+}
+
+ComplexVector block_multiply(
+    const ComplexVector& v, std::size_t kv, const ComplexVector& c,
+    std::size_t kc) {
+  LIBMB_ASSERT(c.size() == kv * kc);
+  const std::size_t n = kv == 0 ? 0 : v.size() / kv;
+  ComplexVector result(n * kc);
+#pragma omp parallel for schedule(static)
+  for (std::size_t i = 0; i < n; i++) {
+    const Complex* vi = v.data() + i * kv;
+    for (std::size_t b = 0; b < kc; b++) {
+      Complex sum{};
+      for (std::size_t a = 0; a < kv; a++) {
+        sum += vi[a] * c[a + b * kv];
+      }
+      result[i * kc + b] = sum;
+    }
+  }
+  return result;
+}
+
+ComplexVector block_column(
+    const ComplexVector& v, std::size_t k, std::size_t j) {
+  LIBMB_ASSERT(j < k);
+  const std::size_t n = v.size() / k;
+  ComplexVector result(n);
+#pragma omp parallel for schedule(static)
+  for (std::size_t i = 0; i < n; i++) {
+    result[i] = v[i * k + j];
+  }
+  return result;
+}
+
+ComplexVector random_vector(std::size_t size, std::mt19937_64& rng) {
+  std::normal_distribution<double> normal;
+  ComplexVector result(size);
+  for (auto& value : result) {
+    const double real = normal(rng);
+    value = {real, normal(rng)};
+  }
+  return result;
+}
+
+ComplexVector orthonormalize(
+    ComplexVector& w, std::size_t k, const std::vector<ComplexVector>& basis,
+    std::size_t basis_width, std::mt19937_64& rng) {
+  const std::size_t n = w.size() / k;
+  auto project_out_basis = [&](ComplexVector& x, std::size_t width) {
+    // Twice is enough to reach orthogonality to working precision.
+    for (std::size_t pass = 0; pass < 2; pass++) {
+      for (const auto& block : basis) {
+        block_subtract(
+            x, width, block, basis_width,
+            block_inner(block, basis_width, x, width));
+      }
+    }
+  };
+  // Norms of the columns before any projection, to detect those that are
+  // lost to cancellation.
+  const ComplexVector gram = block_inner(w, k, w, k);
+  project_out_basis(w, k);
+
+  ComplexVector r(k * k);
+  std::vector<ComplexVector> columns;
+  for (std::size_t j = 0; j < k; j++) {
+    ComplexVector column = block_column(w, k, j);
+    const double original = std::sqrt(gram[j + j * k].real());
+    for (std::size_t pass = 0; pass < 2; pass++) {
+      for (std::size_t i = 0; i < j; i++) {
+        const Complex c = dot(columns[i], column);
+        axpy(-c, columns[i], column);
+        r[i + j * k] += c;
+      }
+    }
+    double length = norm(column);
+    if (length <= 1e-12 * original || length == 0.0) {
+      column = random_vector(n, rng);
+      project_out_basis(column, 1);
+      for (std::size_t pass = 0; pass < 2; pass++) {
+        for (std::size_t i = 0; i < j; i++) {
+          axpy(-dot(columns[i], column), columns[i], column);
+        }
+      }
+      length = norm(column);
+      LIBMB_ASSERT(length > 0.0);
+      r[j + j * k] = 0.0;
+    } else {
+      r[j + j * k] = length;
+    }
+    scale(1.0 / length, column);
+    columns.push_back(std::move(column));
+  }
+
+#pragma omp parallel for schedule(static)
+  for (std::size_t i = 0; i < n; i++) {
+    for (std::size_t j = 0; j < k; j++) {
+      w[i * k + j] = columns[j][i];
+    }
+  }
+  return r;
+}
+
+HermitianEigen hermitian_eigen(ComplexVector a, std::size_t n) {
+  LIBMB_ASSERT(a.size() == n * n);
+  auto at = [&](std::size_t i, std::size_t j) -> Complex& {
+    return a[i + j * n];
+  };
+
+  // Fill the upper triangle from the lower one.
+  for (std::size_t j = 0; j < n; j++) {
+    at(j, j) = at(j, j).real();
+    for (std::size_t i = j + 1; i < n; i++) {
+      at(j, i) = std::conj(at(i, j));
+    }
+  }
+
+  ComplexVector q(n * n);
+  for (std::size_t i = 0; i < n; i++) {
+    q[i + i * n] = 1.0;
+  }
+
+  // Householder reduction: at step k, H = I - beta v v^H zeroes column k of A
+  // below its subdiagonal. A is updated as A - v w^H - w v^H, with
+  // p = beta A v and w = p - (beta v^H p / 2) v.
+  ComplexVector v(n);
+  ComplexVector p(n);
+  for (std::size_t k = 0; k + 2 < n; k++) {
+    double x_norm = 0.0;
+    for (std::size_t i = k + 1; i < n; i++) {
+      x_norm += std::norm(at(i, k));
+    }
+    x_norm = std::sqrt(x_norm);
+    const Complex x0 = at(k + 1, k);
+    const Complex phase = std::abs(x0) == 0.0 ? 1.0 : x0 / std::abs(x0);
+    const Complex alpha = -phase * x_norm;
+
+    double v_norm = 0.0;
+    for (std::size_t i = k + 1; i < n; i++) {
+      v[i] = at(i, k);
+    }
+    v[k + 1] -= alpha;
+    for (std::size_t i = k + 1; i < n; i++) {
+      v_norm += std::norm(v[i]);
+    }
+    if (v_norm == 0.0) {
+      continue;
+    }
+    const double beta = 2.0 / v_norm;
+
+    Complex vp{};
+    for (std::size_t i = k + 1; i < n; i++) {
+      Complex sum{};
+      for (std::size_t j = k + 1; j < n; j++) {
+        sum += at(i, j) * v[j];
+      }
+      p[i] = beta * sum;
+      vp += std::conj(v[i]) * p[i];
+    }
+    const double half = 0.5 * beta * vp.real();
+    for (std::size_t i = k + 1; i < n; i++) {
+      p[i] -= half * v[i];
+    }
+    for (std::size_t j = k + 1; j < n; j++) {
+      for (std::size_t i = k + 1; i < n; i++) {
+        at(i, j) -= v[i] * std::conj(p[j]) + p[i] * std::conj(v[j]);
+      }
+    }
+    at(k + 1, k) = alpha;
+    at(k, k + 1) = std::conj(alpha);
+    for (std::size_t i = k + 2; i < n; i++) {
+      at(i, k) = 0.0;
+      at(k, i) = 0.0;
+    }
+
+    // Q = Q H.
+    for (std::size_t r = 0; r < n; r++) {
+      Complex sum{};
+      for (std::size_t j = k + 1; j < n; j++) {
+        sum += q[r + j * n] * v[j];
+      }
+      sum *= beta;
+      for (std::size_t j = k + 1; j < n; j++) {
+        q[r + j * n] -= sum * std::conj(v[j]);
+      }
+    }
+  }
+
+  // Make the tridiagonal matrix real with a diagonal unitary D, which turns
+  // each subdiagonal element e into |e|, and fold D into Q.
+  std::vector<double> diagonal(n);
+  std::vector<double> off_diagonal(n > 0 ? n - 1 : 0);
+  Complex phase = 1.0;
+  for (std::size_t i = 0; i < n; i++) {
+    diagonal[i] = at(i, i).real();
+    if (i > 0) {
+      const Complex e = at(i, i - 1);
+      off_diagonal[i - 1] = std::abs(e);
+      if (std::abs(e) != 0.0) {
+        phase *= e / std::abs(e);
+      }
+      for (std::size_t r = 0; r < n; r++) {
+        q[r + i * n] *= phase;
+      }
+    }
+  }
+
+  const bool converged = tridiagonal_ql(diagonal, off_diagonal, &q, 60);
+  sort_eigenpairs(diagonal, q);
+  return {std::move(diagonal), std::move(q), converged};
+}
+
+TridiagonalEigen tridiagonal_eigen(
+    std::vector<double> diagonal, std::vector<double> off_diagonal,
+    bool compute_vectors, std::size_t max_iterations) {
+  const std::size_t n = diagonal.size();
+  LIBMB_ASSERT(
+      off_diagonal.size() + 1 == n || (n == 0 && off_diagonal.empty()));
+  std::vector<double> vectors;
+  if (compute_vectors) {
+    vectors.assign(n * n, 0.0);
+    for (std::size_t i = 0; i < n; i++) {
+      vectors[i + i * n] = 1.0;
+    }
+  }
+  const bool converged = tridiagonal_ql(
+      diagonal, off_diagonal, compute_vectors ? &vectors : nullptr,
+      max_iterations);
+  sort_eigenpairs(diagonal, vectors);
+  return {std::move(diagonal), std::move(vectors), converged};
+}
+
+Complex determinant(ComplexVector a, std::size_t n) {
+  LIBMB_ASSERT(a.size() == n * n);
+  auto at = [&](std::size_t i, std::size_t j) -> Complex& {
+    return a[i + j * n];
+  };
+  Complex result = 1.0;
+  for (std::size_t k = 0; k < n; k++) {
+    std::size_t pivot = k;
+    for (std::size_t i = k + 1; i < n; i++) {
+      if (std::abs(at(i, k)) > std::abs(at(pivot, k))) {
+        pivot = i;
+      }
+    }
+    if (at(pivot, k) == Complex{}) {
+      return {};
+    }
+    if (pivot != k) {
+      for (std::size_t j = k; j < n; j++) {
+        std::swap(at(k, j), at(pivot, j));
+      }
+      result = -result;
+    }
+    result *= at(k, k);
+    for (std::size_t i = k + 1; i < n; i++) {
+      const Complex factor = at(i, k) / at(k, k);
+      for (std::size_t j = k + 1; j < n; j++) {
+        at(i, j) -= factor * at(k, j);
+      }
+    }
+  }
+  return result;
+}
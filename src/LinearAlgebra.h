@@ -0,0 +1,99 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include <complex>
+#include <cstddef>
+#include <random>
+#include <vector>
+
+// Dense linear algebra used by the iterative solvers.
+//
+// Small dense matrices are stored column-major, element (i, j) of an n x n
+// matrix being at i + j * n. Blocks of k vectors of length n are stored
+// interleaved, element i of vector j being at i * k + j, so that a sparse
+// matrix applied to a block reads each of its entries once for all k
+// vectors.
+
+using Complex = std::complex<double>;
+using ComplexVector = std::vector<Complex>;
+
+// x^H y.
+Complex dot(const ComplexVector& x, const ComplexVector& y);
+
+double norm(const ComplexVector& x);
+
+// y += a x.
+void axpy(Complex a, const ComplexVector& x, ComplexVector& y);
+
+// x *= a.
+void scale(Complex a, ComplexVector& x);
+
+// V^H W for blocks V of width kv and W of width kw, as a kv x kw matrix.
+ComplexVector block_inner(
+    const ComplexVector& v, std::size_t kv, const ComplexVector& w,
+    std::size_t kw);
+
+// W -= V C for a block V of width kv and a kv x kw matrix C.
+void block_subtract(
+    ComplexVector& w, std::size_t kw, const ComplexVector& v, std::size_t kv,
+    const ComplexVector& c);
+
+// V C for a block V of width kv and a kv x kc matrix C.
+ComplexVector block_multiply(
+    const ComplexVector& v, std::size_t kv, const ComplexVector& c,
+    std::size_t kc);
+
+// Vector j of a block of width k.
+ComplexVector block_column(
+    const ComplexVector& v, std::size_t k, std::size_t j);
+
+// Vector with independent normally distributed components.
+ComplexVector random_vector(std::size_t size, std::mt19937_64& rng);
+
+// Orthonormalises the block w of width k against every block of `basis`,
+// all of width `basis_width` and orthonormal, and within itself. Returns the
+// k x k upper triangular R with w = Q R + basis * (...), Q replacing w.
+// Columns that are linearly dependent on the previous ones are replaced by
+// random vectors orthogonal to everything, with a zero diagonal in R, which
+// requires the basis and w to span at most the whole space.
+ComplexVector orthonormalize(
+    ComplexVector& w, std::size_t k, const std::vector<ComplexVector>& basis,
+    std::size_t basis_width, std::mt19937_64& rng);
+
+struct HermitianEigen {
+  // Ascending eigenvalues.
+  std::vector<double> values;
+  // Eigenvectors as the columns of an n x n matrix.
+  ComplexVector vectors;
+  // False if the QL iteration did not converge, in which case the values
+  // and vectors are inaccurate.
+  bool converged = true;
+};
+
+// Eigendecomposition of the n x n Hermitian matrix `matrix`, of which only
+// the lower triangle is read. The matrix is reduced to a real tridiagonal one
+// by Householder reflections, which is then diagonalised by implicit QL.
+HermitianEigen hermitian_eigen(ComplexVector matrix, std::size_t n);
+
+struct TridiagonalEigen {
+  // Ascending eigenvalues.
+  std::vector<double> values;
+  // Eigenvectors as the columns of an n x n matrix, if requested.
+  std::vector<double> vectors;
+  // False if an eigenvalue needed more than the allowed QL sweeps, in which
+  // case the values and vectors are inaccurate.
+  bool converged = true;
+};
+
+// Eigendecomposition of the real symmetric tridiagonal matrix with the given
+// diagonal and off-diagonal, the latter having one element less, allowing at
+// most max_iterations QL sweeps per eigenvalue.
+TridiagonalEigen tridiagonal_eigen(
+    std::vector<double> diagonal, std::vector<double> off_diagonal,
+    bool compute_vectors = true, std::size_t max_iterations = 60);
+
+// Determinant of the n x n matrix `matrix`, by LU decomposition with partial
+// pivoting.
+Complex determinant(ComplexVector matrix, std::size_t n);
@@ -0,0 +1,89 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "LinearOperator.h"
+
+#include <algorithm>
+#include <memory>
+#include <utility>
+
+namespace {
+
+ComplexVector csr_diagonal(const CsrMatrix<Complex>& matrix) {
+  ComplexVector result(matrix.rows());
+  for (std::size_t r = 0; r < matrix.rows(); r++) {
+    result[r] = matrix(r, r);
+  }
+  return result;
+}
+
+CsrMatrix<Complex> to_csr(
+    const SparseMatrix<Complex>& matrix, std::size_t size) {
+  std::vector<std::vector<std::pair<std::size_t, Complex>>> rows(size);
+  for (const auto& [index, value] : matrix.elements()) {
+    LIBMB_ASSERT(index.i < size && index.j < size);
+    rows[index.i].emplace_back(index.j, value);
+  }
+  std::vector<std::size_t> offsets = {0};
+  std::vector<std::size_t> columns;
+  std::vector<Complex> values;
+  columns.reserve(matrix.size());
+  values.reserve(matrix.size());
+  for (auto& row : rows) {
+    std::sort(row.begin(), row.end(), [](const auto& a, const auto& b) {
+      return a.first < b.first;
+    });
+    for (const auto& [column, value] : row) {
+      columns.push_back(column);
+      values.push_back(value);
+    }
+    offsets.push_back(columns.size());
+  }
+  return {size, std::move(offsets), std::move(columns), std::move(values)};
+}
+
+}  // namespace
+
+LinearOperator::LinearOperator(
+    std::size_t size, BlockFunction apply_block, ComplexVector diagonal)
+    : m_size{size},
+      m_apply_block{std::move(apply_block)},
+      m_diagonal{std::move(diagonal)} {
+  LIBMB_ASSERT(m_diagonal.empty() || m_diagonal.size() == m_size);
+}
+
+LinearOperator::LinearOperator(const CsrMatrix<Complex>& matrix)
+    : m_size{matrix.rows()},
+      m_apply_block{[&matrix](
+                        const ComplexVector& x, ComplexVector& y,
+                        std::size_t k) { matrix.multiply_block(x, y, k); }},
+      m_diagonal{csr_diagonal(matrix)} {
+  LIBMB_ASSERT(matrix.rows() == matrix.cols());
+}
+
+LinearOperator::LinearOperator(
+    const SparseMatrix<Complex>& matrix, std::size_t size)
+    : m_size{size} {
+  // std::function must be copyable, hence the shared ownership.
+  auto csr = std::make_shared<const CsrMatrix<Complex>>(to_csr(matrix, size));
+  m_diagonal = csr_diagonal(*csr);
+  m_apply_block = [csr](
+                      const ComplexVector& x, ComplexVector& y,
+                      std::size_t k) { csr->multiply_block(x, y, k); };
+}
+
+LinearOperator::LinearOperator(const Model& model, const Basis& basis)
+    : m_size{basis.size()},
+      m_apply_block{[&model, &basis](
+                        const ComplexVector& x, ComplexVector& y,
+                        std::size_t k) {
+        model.apply_block(basis, x, y, k);
+      }},
+      m_diagonal{model.compiled_hamiltonian().diagonal(basis)} {}
+
+void LinearOperator::apply_block(
+    const ComplexVector& x, ComplexVector& y, std::size_t k) const {
+  LIBMB_ASSERT(x.size() == m_size * k);
+  y.resize(m_size * k);
+  m_apply_block(x, y, k);
+}
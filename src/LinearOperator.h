@@ -0,0 +1,79 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+#include "Assert.h"
+#include "Basis.h"
+#include "CsrMatrix.h"
+#include "LinearAlgebra.h"
+#include "Model.h"
+#include "SparseMatrix.h"
+
+// A square linear map y = A x consumed by the iterative solvers. It is
+// applied to blocks of k interleaved vectors (see LinearAlgebra.h), so that
+// backends which stream the matrix, or generate it on the fly, do so once
+// per block rather than once per vector.
+//
+// The operator only refers to the matrix or model it was built from, which
+// must outlive it. It may also know its diagonal, which preconditioned
+// solvers use.
+class LinearOperator {
+ public:
+  using BlockFunction = std::function<void(
+      const ComplexVector& x, ComplexVector& y, std::size_t k)>;
+
+  LinearOperator(
+      std::size_t size, BlockFunction apply_block,
+      ComplexVector diagonal = {});
+
+  explicit LinearOperator(const CsrMatrix<Complex>& matrix);
+
+  // A size x size matrix assembled by Model::compute_matrix_elements. It is
+  // converted to CSR, which the operator owns.
+  LinearOperator(const SparseMatrix<Complex>& matrix, std::size_t size);
+
+  // The Hamiltonian of `model` on `basis`, applied without assembling it.
+  // Its diagonal is evaluated from the occupations of the states.
+  LinearOperator(const Model& model, const Basis& basis);
+
+  std::size_t size() const { return m_size; }
+
+  bool has_diagonal() const { return !m_diagonal.empty(); }
+
+  const ComplexVector& diagonal() const {
+    LIBMB_ASSERT(has_diagonal());
+    return m_diagonal;
+  }
+
+  // y = A x.
+  void apply(const ComplexVector& x, ComplexVector& y) const {
+    apply_block(x, y, 1);
+  }
+
+  // Y = A X for a block of k vectors.
+  void apply_block(
+      const ComplexVector& x, ComplexVector& y, std::size_t k) const;
+
+ private:
+  std::size_t m_size;
+  BlockFunction m_apply_block;
+  ComplexVector m_diagonal;
+};
+
+// Eigenpairs computed by an iterative solver.
+struct EigenResult {
+  // Ascending eigenvalues.
+  std::vector<double> values;
+  std::vector<ComplexVector> vectors;
+  // ||A x - lambda x|| for every pair.
+  std::vector<double> residuals;
+  // Number of vectors the operator was applied to.
+  std::size_t applications = 0;
+  std::size_t restarts = 0;
+  bool converged = false;
+};
@@ -1,4 +1,11 @@
 // Copyright (c) 2024 Matheus Sousa
 // SPDX-License-Identifier: BSD-2-Clause
 
-#include "Model.h"
\ No newline at end of file
+#include "Model.h"
+
+const CompiledExpression& Model::compiled_hamiltonian() const {
+  std::call_once(m_compiled_once, [this] {
+    m_compiled = adopt(new CompiledExpression(hamiltonian()));
+  });
+  return *m_compiled;
+}
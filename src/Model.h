@@ -3,8 +3,23 @@
 
 #pragma once
 
+#include <complex>
+#include <mutex>
+#include <string>
+#include <vector>
+
 #include "Basis.h"
+#include "CompiledExpression.h"
 #include "NormalOrder.h"
+#include "Pointers/OwnPtr.h"
+
+// One term of a Hamiltonian written as H = sum_k coefficient_k H_k, where the
+// operators H_k do not depend on the parameters of the model.
+struct HamiltonianPart {
+  std::string name;
+  Term::CoeffType coefficient;
+  std::vector<Term> terms;
+};
 
 class Model {
  public:
@@ -15,31 +30,91 @@ class Model {
   Model(Model&& other) = delete;
   Model& operator=(Model&& other) = delete;
 
+  // Fills mat(r, c) = <r|H|c> for the states of `basis`.
   template <typename SpMat>
   void compute_matrix_elements(const Basis& basis, SpMat& mat) const {
-    const std::vector<Term>& hamilt = hamiltonian();
-#pragma omp parallel for schedule(dynamic)
-    for (const auto& basis_element : basis.elements()) {
-      std::size_t basis_index = basis.index(basis_element);
-      std::vector<Term> terms;
-      terms.reserve(hamilt.size());
-      for (const Term& hamilt_term : hamilt) {
-        terms.push_back(hamilt_term.product(basis_element));
+    const CompiledExpression& hamiltonian = compiled_hamiltonian();
+    const std::size_t size = basis.size();
+#pragma omp parallel
+    {
+      CompiledExpression::Workspace workspace;
+#pragma omp for schedule(dynamic)
+      for (std::size_t r = 0; r < size; r++) {
+        hamiltonian.row(basis, r, basis, workspace);
+#pragma omp critical
+        for (const auto& [column, value] : workspace.entries) {
+          mat(r, column) = value;
+        }
       }
-      for (const auto& [term, coeff] : NormalOrderer(terms).terms()) {
-        if (term.back().type() == Operator::Type::Creation &&
-            basis.contains(term)) {
-          std::size_t term_index = basis.index(term);
+    }
+  }
+
+  // Same as above, with the diagonal of H stored densely in `diagonal` and
+  // only the off-diagonal elements in `off_diagonal`. Diagonal terms are
+  // evaluated from the occupations of each state.
+  template <typename SpMat>
+  void compute_matrix_elements(
+      const Basis& basis, std::vector<std::complex<double>>& diagonal,
+      SpMat& off_diagonal) const {
+    const CompiledExpression& hamiltonian = compiled_hamiltonian();
+    diagonal = hamiltonian.diagonal(basis);
+    const std::size_t size = basis.size();
+#pragma omp parallel
+    {
+      CompiledExpression::Workspace workspace;
+#pragma omp for schedule(dynamic)
+      for (std::size_t r = 0; r < size; r++) {
+        hamiltonian.off_diagonal_row(basis, r, workspace);
 #pragma omp critical
-          mat(basis_index, term_index) = coeff;
+        for (const auto& [column, value] : workspace.entries) {
+          off_diagonal(r, column) = value;
         }
       }
     }
   }
 
+  // y = H x, without assembling the matrix.
+  template <typename Vec>
+  void apply(const Basis& basis, const Vec& x, Vec& y) const {
+    compiled_hamiltonian().apply(basis, x, y);
+  }
+
+  // Y = H X for a block of k interleaved vectors, without assembling the
+  // matrix.
+  template <typename Vec>
+  void apply_block(
+      const Basis& basis, const Vec& x, Vec& y, std::size_t k) const {
+    compiled_hamiltonian().apply_block(basis, x, y, k);
+  }
+
+  CsrMatrix<std::complex<double>> matrix(const Basis& basis) const {
+    return compiled_hamiltonian().matrix(basis);
+  }
+
+  // Upper triangle of the Hamiltonian, which must be Hermitian. Only one term
+  // of each Hermitian pair is evaluated while assembling it.
+  HermitianCsrMatrix<std::complex<double>> hermitian_matrix(
+      const Basis& basis) const {
+    return compiled_hamiltonian().hermitian_matrix(basis);
+  }
+
+  // The Hamiltonian split into parameter-independent parts. Models with
+  // parameters that are swept over override this; by default the whole
+  // Hamiltonian is a single part with coefficient one.
+  virtual std::vector<HamiltonianPart> hamiltonian_parts() const {
+    return {{"", 1.0, hamiltonian()}};
+  }
+
+  // The Hamiltonian compiled on first use and cached for the lifetime of the
+  // model.
+  const CompiledExpression& compiled_hamiltonian() const;
+
  protected:
   Model() = default;
 
  private:
   virtual std::vector<Term> hamiltonian() const = 0;
+
+  mutable std::once_flag m_compiled_once;
+  mutable OwnPtr<CompiledExpression> m_compiled;
 };
@@ -7,24 +7,34 @@
 
 static constexpr auto Fermion = Operator::Statistics::Fermion;
 
-void HubbardChain::hopping_term(std::vector<Term>& result) const {
+void HubbardChain::hopping_term(std::vector<Term>& result, double t) const {
   for (Operator::Spin spin : {Operator::Spin::Up, Operator::Spin::Down}) {
-    for (std::size_t i = 0; i < m_size; i++) {
-      result.push_back(one_body<Fermion>(-m_u, spin, i, spin, i));
-    }
     for (std::size_t i = 0; i < m_size - 1; i++) {
-      result.push_back(one_body<Fermion>(-m_t, spin, i, spin, i + 1));
-      result.push_back(one_body<Fermion>(-m_t, spin, i, spin, i + 1).adjoint());
+      result.push_back(one_body<Fermion>(-t, spin, i, spin, i + 1));
+      result.push_back(one_body<Fermion>(-t, spin, i, spin, i + 1).adjoint());
     }
-    result.push_back(one_body<Fermion>(-m_t, spin, m_size - 1, spin, 0));
+    result.push_back(one_body<Fermion>(-t, spin, m_size - 1, spin, 0));
     result.push_back(
-        one_body<Fermion>(-m_t, spin, m_size - 1, spin, 0).adjoint());
+        one_body<Fermion>(-t, spin, m_size - 1, spin, 0).adjoint());
   }
 }
 
-void HubbardChain::interaction_term(std::vector<Term>& result) const {
+void HubbardChain::interaction_term(std::vector<Term>& result, double u) const {
+  for (Operator::Spin spin : {Operator::Spin::Up, Operator::Spin::Down}) {
+    for (std::size_t i = 0; i < m_size; i++) {
+      result.push_back(one_body<Fermion>(-u, spin, i, spin, i));
+    }
+  }
   for (size_t i1 = 0; i1 < m_size; i1++) {
     result.push_back(density_density<Fermion>(
-        m_u, Operator::Spin::Up, i1, Operator::Spin::Down, i1));
+        u, Operator::Spin::Up, i1, Operator::Spin::Down, i1));
   }
 }
+
+std::vector<HamiltonianPart> HubbardChain::hamiltonian_parts() const {
+  std::vector<Term> hopping;
+  hopping_term(hopping, 1.0);
+  std::vector<Term> interaction;
+  interaction_term(interaction, 1.0);
+  return {{"t", m_t, hopping}, {"u", m_u, interaction}};
+}
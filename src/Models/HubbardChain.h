@@ -11,15 +11,17 @@ class HubbardChain : public Model {
 
   ~HubbardChain() override {}
 
+  std::vector<HamiltonianPart> hamiltonian_parts() const override;
+
  private:
-  void hopping_term(std::vector<Term>& result) const;
+  void hopping_term(std::vector<Term>& result, double t) const;
 
-  void interaction_term(std::vector<Term>& result) const;
+  void interaction_term(std::vector<Term>& result, double u) const;
 
   std::vector<Term> hamiltonian() const override {
     std::vector<Term> result;
-    hopping_term(result);
-    interaction_term(result);
+    hopping_term(result, m_t);
+    interaction_term(result, m_u);
     return result;
   }
 
@@ -8,7 +8,8 @@
 
 static constexpr auto Fermion = Operator::Statistics::Fermion;
 
-void HubbardChainKSpace::hopping_term(std::vector<Term>& result) const {
+void HubbardChainKSpace::hopping_term(
+    std::vector<Term>& result, double t) const {
   auto index = [&](size_t i) {
     // The index will make the sequence
     // 0, 1, 2, ..., m_particles
@@ -25,19 +26,20 @@ void HubbardChainKSpace::hopping_term(std::vector<Term>& result) const {
                  static_cast<double>(index(i)) / static_cast<double>(m_size);
       double a = m_size == 2 ? 1 : 2;
       result.push_back(
-          one_body<Fermion>(-a * m_t * std::cos(k), spin, i, spin, i));
+          one_body<Fermion>(-a * t * std::cos(k), spin, i, spin, i));
     }
   }
 }
 
-void HubbardChainKSpace::interaction_term(std::vector<Term>& result) const {
+void HubbardChainKSpace::interaction_term(
+    std::vector<Term>& result, double u) const {
   for (std::size_t k1 = 0; k1 < m_size; k1++) {
     for (std::size_t k2 = 0; k2 < m_size; k2++) {
       for (std::size_t k3 = 0; k3 < m_size; k3++) {
         for (std::size_t k4 = 0; k4 < m_size; k4++) {
           if (((k2 + k4) % m_size == (k1 + k3) % m_size)) {
             result.push_back(Term(
-                m_u / static_cast<double>(m_size),
+                u / static_cast<double>(m_size),
                 {Operator::creation<Fermion>(Operator::Spin::Up, k1),
                  Operator::annihilation<Fermion>(Operator::Spin::Up, k2),
                  Operator::creation<Fermion>(Operator::Spin::Down, k3),
@@ -48,3 +50,11 @@ void HubbardChainKSpace::interaction_term(std::vector<Term>& result) const {
     }
   }
 }
+
+std::vector<HamiltonianPart> HubbardChainKSpace::hamiltonian_parts() const {
+  std::vector<Term> hopping;
+  hopping_term(hopping, 1.0);
+  std::vector<Term> interaction;
+  interaction_term(interaction, 1.0);
+  return {{"t", m_t, hopping}, {"u", m_u, interaction}};
+}
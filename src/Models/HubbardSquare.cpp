@@ -7,7 +7,7 @@
 
 static constexpr auto Fermion = Operator::Statistics::Fermion;
 
-void HubbardSquare::hopping_term(std::vector<Term>& result) const {
+void HubbardSquare::hopping_term(std::vector<Term>& result, double t) const {
   auto index = [&](size_t i, size_t j) { return j * m_nx + i; };
   for (size_t i = 0; i < m_nx; i++) {
     for (size_t j = 0; j < m_ny; j++) {
@@ -15,21 +15,30 @@ void HubbardSquare::hopping_term(std::vector<Term>& result) const {
         size_t dsti = i < m_nx - 1 ? i + 1 : 0;
         size_t dstj = j < m_ny - 1 ? j + 1 : 0;
         result.push_back(
-            one_body<Fermion>(-m_t, spin, index(i, j), spin, index(dsti, j)));
+            one_body<Fermion>(-t, spin, index(i, j), spin, index(dsti, j)));
         result.push_back(
-            one_body<Fermion>(-m_t, spin, index(dsti, j), spin, index(i, j)));
+            one_body<Fermion>(-t, spin, index(dsti, j), spin, index(i, j)));
         result.push_back(
-            one_body<Fermion>(-m_t, spin, index(i, j), spin, index(i, dstj)));
+            one_body<Fermion>(-t, spin, index(i, j), spin, index(i, dstj)));
         result.push_back(
-            one_body<Fermion>(-m_t, spin, index(i, dstj), spin, index(i, j)));
+            one_body<Fermion>(-t, spin, index(i, dstj), spin, index(i, j)));
       }
     }
   }
 }
 
-void HubbardSquare::interaction_term(std::vector<Term>& result) const {
+void HubbardSquare::interaction_term(
+    std::vector<Term>& result, double u) const {
   for (size_t i1 = 0; i1 < m_nx * m_ny; i1++) {
     result.push_back(density_density<Fermion>(
-        m_u, Operator::Spin::Up, i1, Operator::Spin::Down, i1));
+        u, Operator::Spin::Up, i1, Operator::Spin::Down, i1));
   }
 }
+
+std::vector<HamiltonianPart> HubbardSquare::hamiltonian_parts() const {
+  std::vector<Term> hopping;
+  hopping_term(hopping, 1.0);
+  std::vector<Term> interaction;
+  interaction_term(interaction, 1.0);
+  return {{"t", m_t, hopping}, {"u", m_u, interaction}};
+}
@@ -5,19 +5,36 @@
 
 static constexpr auto Fermion = Operator::Statistics::Fermion;
 
-std::vector<Term> LinearChain::hamiltonian() const {
-  std::vector<Term> terms;
+void LinearChain::hopping_term(std::vector<Term>& terms, double t) const {
   for (Operator::Spin spin : {Operator::Spin::Up, Operator::Spin::Down}) {
-    for (std::size_t i = 0; i < m_size; i++) {
-      terms.push_back(one_body<Fermion>(-m_u, spin, i, spin, i));
-    }
     for (std::size_t i = 0; i < m_size - 1; i++) {
-      terms.push_back(one_body<Fermion>(-m_t, spin, i, spin, i + 1));
-      terms.push_back(one_body<Fermion>(-m_t, spin, i, spin, i + 1).adjoint());
+      terms.push_back(one_body<Fermion>(-t, spin, i, spin, i + 1));
+      terms.push_back(one_body<Fermion>(-t, spin, i, spin, i + 1).adjoint());
+    }
+    terms.push_back(one_body<Fermion>(-t, spin, m_size - 1, spin, 0));
+    terms.push_back(one_body<Fermion>(-t, spin, m_size - 1, spin, 0).adjoint());
+  }
+}
+
+void LinearChain::onsite_term(std::vector<Term>& terms, double u) const {
+  for (Operator::Spin spin : {Operator::Spin::Up, Operator::Spin::Down}) {
+    for (std::size_t i = 0; i < m_size; i++) {
+      terms.push_back(one_body<Fermion>(-u, spin, i, spin, i));
     }
-    terms.push_back(one_body<Fermion>(-m_t, spin, m_size - 1, spin, 0));
-    terms.push_back(
-        one_body<Fermion>(-m_t, spin, m_size - 1, spin, 0).adjoint());
   }
+}
+
+std::vector<Term> LinearChain::hamiltonian() const {
+  std::vector<Term> terms;
+  hopping_term(terms, m_t);
+  onsite_term(terms, m_u);
   return terms;
 }
+
+std::vector<HamiltonianPart> LinearChain::hamiltonian_parts() const {
+  std::vector<Term> hopping;
+  hopping_term(hopping, 1.0);
+  std::vector<Term> onsite;
+  onsite_term(onsite, 1.0);
+  return {{"t", m_t, hopping}, {"u", m_u, onsite}};
+}
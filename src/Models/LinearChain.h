@@ -11,7 +11,13 @@ class LinearChain : public Model {
 
   ~LinearChain() override {}
 
+  std::vector<HamiltonianPart> hamiltonian_parts() const override;
+
  private:
+  void hopping_term(std::vector<Term>& terms, double t) const;
+
+  void onsite_term(std::vector<Term>& terms, double u) const;
+
   std::vector<Term> hamiltonian() const override;
 
   std::size_t m_size;
@@ -3,6 +3,9 @@
 
 #include "NormalOrder.h"
 
+#include <array>
+#include <bit>
+#include <cstdint>
 #include <vector>
 
 constexpr Term::CoeffType evaluate_parity(
@@ -10,32 +13,49 @@ constexpr Term::CoeffType evaluate_parity(
   return phase % 2 == 0 ? coefficient : -coefficient;
 }
 
-NormalOrderer::NormalOrderer(const Term& term) {
+NormalOrderer::NormalOrderer(
+    const Term& term, const NormalOrderOptions& options)
+    : m_options{options} {
   normal_order(term.operators(), term.coefficient());
+  prune();
 }
 
-NormalOrderer::NormalOrderer(const std::vector<Term>& terms) {
+NormalOrderer::NormalOrderer(
+    const std::vector<Term>& terms, const NormalOrderOptions& options)
+    : m_options{options} {
   for (const Term& term : terms) {
     normal_order(term.operators(), term.coefficient());
   }
+  prune();
 }
 
-NormalOrderer::NormalOrderer(const Expression& expression) {
+NormalOrderer::NormalOrderer(
+    const Expression& expression, const NormalOrderOptions& options)
+    : m_options{options} {
   for (const auto& [operators, coeff] : expression.terms()) {
     normal_order(operators, coeff);
   }
+  prune();
 }
 
-NormalOrderer::NormalOrderer(const std::vector<Expression>& expressions) {
+NormalOrderer::NormalOrderer(
+    const std::vector<Expression>& expressions,
+    const NormalOrderOptions& options)
+    : m_options{options} {
   for (const Expression& expression : expressions) {
     for (const auto& [operators, coeff] : expression.terms()) {
       normal_order(operators, coeff);
     }
   }
+  prune();
 }
 
 void NormalOrderer::normal_order(
     const std::vector<Operator>& operators, Term::CoeffType coefficient) {
+  if (std::abs(coefficient) < m_options.threshold ||
+      !within_reach(operators)) {
+    return;
+  }
   m_stack.emplace_back(operators, 0);
   m_elements.reserve(operators.size());
 
@@ -50,7 +70,41 @@ void NormalOrderer::normal_order(
 
     auto [new_operators, new_phase] =
         sort_operators(prev_operators, prev_phase);
-    m_terms_map[new_operators] += evaluate_parity(coefficient, new_phase);
+    if (m_options.max_length == 0 ||
+        new_operators.size() <= m_options.max_length) {
+      m_terms_map[new_operators] += evaluate_parity(coefficient, new_phase);
+    }
+  }
+}
+
+bool NormalOrderer::within_reach(
+    const std::vector<Operator>& operators) const {
+  if (m_options.max_length == 0 ||
+      operators.size() <= m_options.max_length) {
+    return true;
+  }
+  // Every contraction pairs an annihilation operator with a creation
+  // operator of the same mode to its right, so their number is at most that
+  // of such disjoint pairs.
+  std::array<std::size_t, 128> open{};
+  std::size_t contractions = 0;
+  for (const Operator& op : operators) {
+    std::size_t& count = open[op.identifier()];
+    if (op.type() == Operator::Type::Annihilation) {
+      count++;
+    } else if (count > 0) {
+      count--;
+      contractions++;
+    }
+  }
+  return operators.size() - 2 * contractions <= m_options.max_length;
+}
+
+void NormalOrderer::prune() {
+  if (m_options.threshold > 0.0) {
+    std::erase_if(m_terms_map, [&](const auto& entry) {
+      return std::abs(entry.second) < m_options.threshold;
+    });
   }
 }
 
@@ -80,7 +134,9 @@ NormalOrderer::OperatorsPhasePair NormalOrderer::sort_operators(
               m_elements.end(), operators.begin(), operators.end());
           m_elements.erase(
               m_elements.begin() + j - 1, m_elements.begin() + j + 1);
-          m_stack.emplace_back(m_elements, phase);
+          if (within_reach(m_elements)) {
+            m_stack.emplace_back(m_elements, phase);
+          }
         }
         std::swap(op1, op2);
         phase += op1.is_fermion() && op2.is_fermion();
@@ -90,27 +146,106 @@ NormalOrderer::OperatorsPhasePair NormalOrderer::sort_operators(
   return OperatorsPhasePair{operators, phase};
 }
 
-Expression commute(const Term& term1, const Term& term2) {
-  return NormalOrderer({term1.product(term2), term2.product(term1).negate()})
+Expression commute(
+    const Term& term1, const Term& term2, const NormalOrderOptions& options) {
+  return NormalOrderer(
+             {term1.product(term2), term2.product(term1).negate()}, options)
       .expression();
 }
 
 Expression commute(
-    const Expression& expression1, const Expression& expression2) {
-  return NormalOrderer({expression1.product(expression2),
-                        expression2.product(expression1).negate()})
+    const Expression& expression1, const Expression& expression2,
+    const NormalOrderOptions& options) {
+  return NormalOrderer(
+             {expression1.product(expression2),
+              expression2.product(expression1).negate()},
+             options)
       .expression();
 }
 
-Expression anticommute(const Term& term1, const Term& term2) {
-  return NormalOrderer({term1.product(term2), term2.product(term1)})
+Expression anticommute(
+    const Term& term1, const Term& term2, const NormalOrderOptions& options) {
+  return NormalOrderer({term1.product(term2), term2.product(term1)}, options)
       .expression();
 }
 
 Expression anticommute(
-    const Expression& expression1, const Expression& expression2) {
-  return NormalOrderer({expression1.product(expression2),
-                        expression2.product(expression1)})
+    const Expression& expression1, const Expression& expression2,
+    const NormalOrderOptions& options) {
+  return NormalOrderer(
+             {expression1.product(expression2),
+              expression2.product(expression1)},
+             options)
       .expression();
   ;
 }
+
+Term::CoeffType vacuum_expectation(const std::vector<Operator>& operators) {
+  // Occupations of the modes, indexed by identifier, acting on the states
+  // prod_m (a^dagger_m)^{n_m} |0> with the fermionic modes in ascending
+  // order; bosonic states are not normalised, so a |n> = n |n - 1>.
+  std::array<std::size_t, 128> occupation{};
+  std::array<std::uint64_t, 2> fermions{};
+  std::size_t quanta = 0;
+  double factor = 1.0;
+  bool parity = false;
+  for (auto it = operators.rbegin(); it != operators.rend(); ++it) {
+    const Operator& op = *it;
+    const std::size_t mode = op.identifier();
+    const bool creation = op.type() == Operator::Type::Creation;
+    if (op.is_fermion()) {
+      const std::uint64_t bit = std::uint64_t{1} << (mode % 64);
+      std::uint64_t& word = fermions[mode / 64];
+      if (((word & bit) != 0) == creation) {
+        return {};
+      }
+      const int below = std::popcount(word & (bit - 1)) +
+                        (mode >= 64 ? std::popcount(fermions[0]) : 0);
+      parity ^= (below & 1) != 0;
+      word ^= bit;
+    } else if (!creation) {
+      if (occupation[mode] == 0) {
+        return {};
+      }
+      factor *= static_cast<double>(occupation[mode]--);
+    } else {
+      occupation[mode]++;
+    }
+    quanta = creation ? quanta + 1 : quanta - 1;
+  }
+  if (quanta != 0) {
+    return {};
+  }
+  return parity ? -factor : factor;
+}
+
+Term::CoeffType vacuum_expectation(const Term& term) {
+  return term.coefficient() * vacuum_expectation(term.operators());
+}
+
+Term::CoeffType vacuum_expectation(const Expression& expression) {
+  Term::CoeffType result{};
+  for (const auto& [operators, coefficient] : expression.terms()) {
+    result += coefficient * vacuum_expectation(operators);
+  }
+  return result;
+}
+
+Term::CoeffType reference_expectation(
+    const Expression& expression, const std::vector<Operator>& reference) {
+  // <0| reference^dagger O reference |0>.
+  std::vector<Operator> bra;
+  for (auto it = reference.rbegin(); it != reference.rend(); ++it) {
+    bra.push_back(it->adjoint());
+  }
+  std::vector<Operator> operators;
+  Term::CoeffType result{};
+  for (const auto& [term_operators, coefficient] : expression.terms()) {
+    operators = bra;
+    operators.insert(
+        operators.end(), term_operators.begin(), term_operators.end());
+    operators.insert(operators.end(), reference.begin(), reference.end());
+    result += coefficient * vacuum_expectation(operators);
+  }
+  return result;
+}
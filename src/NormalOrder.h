@@ -9,17 +9,34 @@
 // i.e. they are all fermionic or all bosonic. Normal order between
 // fermionic and bosonic operators is not well defined.
 
+// Truncation of the normal ordered result, for approximations that keep
+// only terms up to a given number of operators.
+struct NormalOrderOptions {
+  // Terms with more operators are dropped; zero means no limit. Strings are
+  // pruned while being ordered as soon as none of the terms they can still
+  // produce, each contraction removing two operators, is short enough.
+  std::size_t max_length = 0;
+  // Input terms, and accumulated results, with a coefficient of smaller
+  // magnitude are dropped. Contractions do not change the magnitude of the
+  // coefficient, so a dropped input term never has to be expanded.
+  double threshold = 0.0;
+};
+
 class NormalOrderer {
  public:
   using OperatorsPhasePair = std::pair<std::vector<Operator>, std::size_t>;
 
-  NormalOrderer(const Term& term);
+  NormalOrderer(const Term& term, const NormalOrderOptions& options = {});
 
-  NormalOrderer(const std::vector<Term>& terms);
+  NormalOrderer(
+      const std::vector<Term>& terms, const NormalOrderOptions& options = {});
 
-  NormalOrderer(const Expression& expression);
+  NormalOrderer(
+      const Expression& expression, const NormalOrderOptions& options = {});
 
-  NormalOrderer(const std::vector<Expression>& expressions);
+  NormalOrderer(
+      const std::vector<Expression>& expressions,
+      const NormalOrderOptions& options = {});
 
   Expression::ExpressionMap terms() const { return m_terms_map; }
 
@@ -32,14 +49,41 @@ class NormalOrderer {
   OperatorsPhasePair sort_operators(
       std::vector<Operator> operators, std::size_t phase);
 
+  // Whether ordering `operators` can produce a term within max_length.
+  bool within_reach(const std::vector<Operator>& operators) const;
+
+  // Drops the accumulated terms below the threshold.
+  void prune();
+
+  NormalOrderOptions m_options;
   std::vector<OperatorsPhasePair> m_stack;
   Expression::ExpressionMap m_terms_map;
   std::vector<Operator> m_elements;
 };
 
-Expression commute(const Term& term1, const Term& term2);
 Expression commute(
-    const Expression& expression1, const Expression& expression2);
-Expression anticommute(const Term& term1, const Term& term2);
+    const Term& term1, const Term& term2,
+    const NormalOrderOptions& options = {});
+Expression commute(
+    const Expression& expression1, const Expression& expression2,
+    const NormalOrderOptions& options = {});
+Expression anticommute(
+    const Term& term1, const Term& term2,
+    const NormalOrderOptions& options = {});
 Expression anticommute(
-    const Expression& expression1, const Expression& expression2);
+    const Expression& expression1, const Expression& expression2,
+    const NormalOrderOptions& options = {});
+
+// <0|O|0>. Each string is applied right to left to the occupation numbers of
+// the vacuum, which adds up exactly its fully contracted Wick pairings
+// without generating the uncontracted terms that normal ordering would, in
+// time linear in the length of the string.
+Term::CoeffType vacuum_expectation(const std::vector<Operator>& operators);
+Term::CoeffType vacuum_expectation(const Term& term);
+Term::CoeffType vacuum_expectation(const Expression& expression);
+
+// <R|O|R> for the occupation-number state |R> = reference |0>, with
+// `reference` a product of creation operators such as a basis element. As
+// for the basis elements, bosonic states are not normalised.
+Term::CoeffType reference_expectation(
+    const Expression& expression, const std::vector<Operator>& reference);
@@ -0,0 +1,168 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "ObservableSet.h"
+
+#include <map>
+#include <unordered_map>
+#include <utility>
+
+#include "FermionicState.h"
+
+ObservableSet::ObservableSet(const std::vector<Expression>& observables) {
+  std::map<std::pair<std::uint8_t, std::uint8_t>, std::vector<Weight>>
+      hopping;
+  std::map<std::array<std::uint8_t, 4>, std::vector<Weight>> two_body;
+  std::unordered_map<std::vector<Operator>, std::vector<Weight>> strings;
+
+  m_observables.reserve(observables.size());
+  for (std::size_t i = 0; i < observables.size(); i++) {
+    const CompiledExpression& compiled =
+        m_observables.emplace_back(observables[i]);
+    if (!compiled.generic_terms().empty()) {
+      m_generic.push_back(i);
+      continue;
+    }
+    if (!compiled.diagonal_terms().empty()) {
+      m_diagonal.push_back(i);
+    }
+    for (const auto& [to, from, coefficient] : compiled.hopping_terms()) {
+      hopping[{to, from}].push_back({i, coefficient});
+    }
+    for (const auto& [slots, coefficient] : compiled.two_body_terms()) {
+      two_body[slots].push_back({i, coefficient});
+    }
+    for (const Term& term : compiled.fermionic_terms()) {
+      strings[term.operators()].push_back({i, term.coefficient()});
+    }
+  }
+
+  auto add_weights = [&](const std::vector<Weight>& weights) {
+    const std::size_t begin = m_weights.size();
+    m_weights.insert(m_weights.end(), weights.begin(), weights.end());
+    return std::pair{begin, m_weights.size()};
+  };
+  for (const auto& [key, weights] : hopping) {
+    const auto [begin, end] = add_weights(weights);
+    m_hopping.push_back({key.first, key.second, begin, end});
+  }
+  for (const auto& [slots, weights] : two_body) {
+    const auto [begin, end] = add_weights(weights);
+    m_two_body.push_back({slots, begin, end});
+  }
+  for (const auto& [operators, weights] : strings) {
+    std::vector<std::uint8_t> encoded;
+    for (const Operator& op : operators) {
+      encoded.push_back(static_cast<std::uint8_t>(
+          2 * fermion_slot(op) +
+          (op.type() == Operator::Type::Creation ? 1 : 0)));
+    }
+    const auto [begin, end] = add_weights(weights);
+    m_strings.push_back({std::move(encoded), begin, end});
+  }
+}
+
+std::vector<Complex> ObservableSet::expectation(
+    const Basis& basis, const ComplexVector& x) const {
+  LIBMB_ASSERT(x.size() == basis.size());
+  const std::size_t size = basis.size();
+  std::vector<Complex> result(m_observables.size());
+#pragma omp parallel
+  {
+    std::vector<Complex> local(m_observables.size());
+    CompiledExpression::Workspace workspace;
+    BasisElement element;
+
+    // sum_c <r|O_i|c> x_c, times the conjugate amplitude of the row.
+    auto by_row = [&](std::size_t i, std::size_t r, Complex amplitude) {
+      m_observables[i].row(basis, r, basis, workspace);
+      Complex sum{};
+      for (const auto& [column, value] : workspace.entries) {
+        sum += value * x[column];
+      }
+      local[i] += amplitude * sum;
+    };
+
+#pragma omp for schedule(dynamic, 64)
+    for (std::size_t r = 0; r < size; r++) {
+      const Complex amplitude = std::conj(x[r]);
+      if (amplitude == Complex{}) {
+        continue;
+      }
+      const BasisElement& state = basis.elements()[r];
+      if (!is_fermionic_state(state)) {
+        for (std::size_t i = 0; i < m_observables.size(); i++) {
+          by_row(i, r, amplitude);
+        }
+        continue;
+      }
+      for (std::size_t i : m_generic) {
+        by_row(i, r, amplitude);
+      }
+
+      const std::uint64_t mask = occupation_mask(state);
+      const double weight = std::norm(x[r]);
+      for (std::size_t i : m_diagonal) {
+        local[i] += weight * m_observables[i].diagonal_value(mask);
+      }
+
+      // As in CompiledExpression, <r|O|c> is read off by applying the
+      // adjoint string to |r>.
+      auto emit = [&](std::uint64_t target, bool parity, std::size_t begin,
+                      std::size_t end) {
+        fermionic_state(target, element);
+        const std::size_t column = basis.find(element);
+        if (column == size) {
+          return;
+        }
+        const Complex value = parity ? -amplitude * x[column]
+                                     : amplitude * x[column];
+        for (std::size_t k = begin; k < end; k++) {
+          local[m_weights[k].observable] += m_weights[k].coefficient * value;
+        }
+      };
+
+      for (const auto& [to, from, begin, end] : m_hopping) {
+        std::uint64_t target = mask;
+        bool parity = false;
+        if (annihilate_slot(target, to, parity) &&
+            create_slot(target, from, parity)) {
+          emit(target, parity, begin, end);
+        }
+      }
+
+      for (const auto& [slots, begin, end] : m_two_body) {
+        std::uint64_t target = mask;
+        bool parity = false;
+        if (annihilate_slot(target, slots[0], parity) &&
+            annihilate_slot(target, slots[1], parity) &&
+            create_slot(target, slots[2], parity) &&
+            create_slot(target, slots[3], parity)) {
+          emit(target, parity, begin, end);
+        }
+      }
+
+      for (const auto& [operators, begin, end] : m_strings) {
+        std::uint64_t target = mask;
+        bool parity = false;
+        bool nonzero = true;
+        for (const std::uint8_t op : operators) {
+          nonzero = (op & 1) != 0 ? annihilate_slot(target, op / 2, parity)
+                                  : create_slot(target, op / 2, parity);
+          if (!nonzero) {
+            break;
+          }
+        }
+        if (nonzero) {
+          emit(target, parity, begin, end);
+        }
+      }
+    }
+
+#pragma omp critical
+    for (std::size_t i = 0; i < result.size(); i++) {
+      result[i] += local[i];
+    }
+  }
+  return result;
+}
@@ -0,0 +1,85 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "Basis.h"
+#include "CompiledExpression.h"
+#include "Expression.h"
+#include "LinearAlgebra.h"
+#include "StateVector.h"
+
+// Expectation values of many observables, e.g. all the correlators
+// <S_i . S_j>, measured in one sweep over the state.
+//
+// The off-diagonal fermionic terms of all the observables are merged, so
+// that each distinct operator string is stored once with the list of the
+// observables it appears in and their coefficients. For every basis state
+// the occupation bitmask is decoded once, the diagonal parts are evaluated
+// on it with bit operations, and each string is applied to it and looked up
+// in the basis once, however many observables contain it. Observables with
+// bosonic terms, and states that are not fermionic, are handled row by row
+// through CompiledExpression.
+class ObservableSet {
+ public:
+  explicit ObservableSet(const std::vector<Expression>& observables);
+
+  std::size_t size() const { return m_observables.size(); }
+
+  const CompiledExpression& operator[](std::size_t i) const {
+    return m_observables[i];
+  }
+
+  // <x|O_i|x> for every observable, for a state x given in `basis`.
+  std::vector<Complex> expectation(
+      const Basis& basis, const ComplexVector& x) const;
+
+  std::vector<Complex> expectation(const StateVector& state) const {
+    return expectation(state.basis(), state.amplitudes());
+  }
+
+ private:
+  // Coefficient of an operator string in one of the observables.
+  struct Weight {
+    std::size_t observable;
+    Complex coefficient;
+  };
+
+  // Operator strings, with their weights at positions begin to end of
+  // m_weights. The slots are those of CompiledExpression::HoppingTerm and
+  // TwoBodyTerm; longer strings store 2 * slot + 1 for a creation operator
+  // and 2 * slot for an annihilation operator.
+  struct HoppingString {
+    std::uint8_t to;
+    std::uint8_t from;
+    std::size_t begin;
+    std::size_t end;
+  };
+
+  struct TwoBodyString {
+    std::array<std::uint8_t, 4> slots;
+    std::size_t begin;
+    std::size_t end;
+  };
+
+  struct LongString {
+    std::vector<std::uint8_t> operators;
+    std::size_t begin;
+    std::size_t end;
+  };
+
+  std::vector<CompiledExpression> m_observables;
+  // Observables evaluated through the merged strings that have a diagonal
+  // part, and those that are evaluated row by row.
+  std::vector<std::size_t> m_diagonal;
+  std::vector<std::size_t> m_generic;
+  std::vector<HoppingString> m_hopping;
+  std::vector<TwoBodyString> m_two_body;
+  std::vector<LongString> m_strings;
+  std::vector<Weight> m_weights;
+};
@@ -0,0 +1,75 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include <omp.h>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <vector>
+
+// Stable parallel merge sort. The range is split into one chunk per thread,
+// the chunks are sorted concurrently and then merged pairwise, also
+// concurrently, until a single run is left. Since every step is stable, the
+// result is the same as std::stable_sort independently of the number of
+// threads.
+template <class RandomIt, class Compare>
+void parallel_sort(RandomIt first, RandomIt last, Compare comp) {
+  using value_type = typename std::iterator_traits<RandomIt>::value_type;
+  using difference_type =
+      typename std::iterator_traits<RandomIt>::difference_type;
+
+  const auto size = static_cast<std::size_t>(std::distance(first, last));
+  const std::size_t min_chunk_size = 1 << 12;
+  const std::size_t chunks = std::min(
+      static_cast<std::size_t>(omp_get_max_threads()),
+      size / min_chunk_size);
+
+  if (chunks < 2) {
+    std::stable_sort(first, last, comp);
+    return;
+  }
+
+  // Boundaries of the sorted runs, as offsets from the beginning of the range.
+  std::vector<difference_type> bounds(chunks + 1);
+  for (std::size_t k = 0; k <= chunks; k++) {
+    bounds[k] = static_cast<difference_type>(k * size / chunks);
+  }
+
+#pragma omp parallel for schedule(static)
+  for (std::size_t k = 0; k < chunks; k++) {
+    std::stable_sort(first + bounds[k], first + bounds[k + 1], comp);
+  }
+
+  std::vector<value_type> buffer(size);
+  bool in_buffer = false;
+  for (std::size_t width = 1; width < chunks; width *= 2) {
+    const std::size_t merges = (chunks + 2 * width - 1) / (2 * width);
+#pragma omp parallel for schedule(dynamic)
+    for (std::size_t m = 0; m < merges; m++) {
+      difference_type lo = bounds[2 * m * width];
+      difference_type mid = bounds[std::min(chunks, (2 * m + 1) * width)];
+      difference_type hi = bounds[std::min(chunks, (2 * m + 2) * width)];
+      if (in_buffer) {
+        std::merge(
+            std::make_move_iterator(buffer.begin() + lo),
+            std::make_move_iterator(buffer.begin() + mid),
+            std::make_move_iterator(buffer.begin() + mid),
+            std::make_move_iterator(buffer.begin() + hi), first + lo, comp);
+      } else {
+        std::merge(
+            std::make_move_iterator(first + lo),
+            std::make_move_iterator(first + mid),
+            std::make_move_iterator(first + mid),
+            std::make_move_iterator(first + hi), buffer.begin() + lo, comp);
+      }
+    }
+    in_buffer = !in_buffer;
+  }
+
+  if (in_buffer) {
+    std::move(buffer.begin(), buffer.end(), first);
+  }
+}
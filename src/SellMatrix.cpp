@@ -0,0 +1,202 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "SellMatrix.h"
+
+#include <algorithm>
+#include <limits>
+#include <numeric>
+
+#include "Assert.h"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define LIBMB_HAS_X86_KERNELS
+#include <immintrin.h>
+#endif
+
+namespace {
+
+constexpr std::size_t C = SellMatrix::chunk_size;
+
+// Accumulates the products of one chunk of `width` columns into the C lanes of
+// `real` and `imag`. `x` points to the interleaved real and imaginary parts.
+using ChunkKernel = void (*)(
+    std::size_t width, const std::int32_t* columns, const double* values_real,
+    const double* values_imag, const double* x, double* real, double* imag);
+
+void chunk_scalar(
+    std::size_t width, const std::int32_t* columns, const double* values_real,
+    const double* values_imag, const double* x, double* real, double* imag) {
+  for (std::size_t lane = 0; lane < C; lane++) {
+    real[lane] = 0.0;
+    imag[lane] = 0.0;
+  }
+  for (std::size_t j = 0; j < width; j++) {
+    for (std::size_t lane = 0; lane < C; lane++) {
+      const std::size_t k = j * C + lane;
+      const double xr = x[columns[k]];
+      const double xi = x[columns[k] + 1];
+      real[lane] += values_real[k] * xr - values_imag[k] * xi;
+      imag[lane] += values_real[k] * xi + values_imag[k] * xr;
+    }
+  }
+}
+
+#ifdef LIBMB_HAS_X86_KERNELS
+
+__attribute__((target("avx2,fma"))) void chunk_avx2(
+    std::size_t width, const std::int32_t* columns, const double* values_real,
+    const double* values_imag, const double* x, double* real, double* imag) {
+  // The masked gathers, with every lane enabled, are used because the plain
+  // ones leave their source operand undefined, which GCC warns about.
+  const __m256d zero = _mm256_setzero_pd();
+  const __m256d all = _mm256_castsi256_pd(_mm256_set1_epi64x(-1));
+  __m256d real_low = _mm256_setzero_pd();
+  __m256d imag_low = _mm256_setzero_pd();
+  __m256d real_high = _mm256_setzero_pd();
+  __m256d imag_high = _mm256_setzero_pd();
+  for (std::size_t j = 0; j < width; j++) {
+    const std::size_t k = j * C;
+    const __m128i index_low =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(columns + k));
+    const __m128i index_high =
+        _mm_loadu_si128(reinterpret_cast<const __m128i*>(columns + k + 4));
+
+    __m256d xr = _mm256_mask_i32gather_pd(zero, x, index_low, all, 8);
+    __m256d xi = _mm256_mask_i32gather_pd(zero, x + 1, index_low, all, 8);
+    __m256d vr = _mm256_loadu_pd(values_real + k);
+    __m256d vi = _mm256_loadu_pd(values_imag + k);
+    real_low = _mm256_fnmadd_pd(vi, xi, _mm256_fmadd_pd(vr, xr, real_low));
+    imag_low = _mm256_fmadd_pd(vi, xr, _mm256_fmadd_pd(vr, xi, imag_low));
+
+    xr = _mm256_mask_i32gather_pd(zero, x, index_high, all, 8);
+    xi = _mm256_mask_i32gather_pd(zero, x + 1, index_high, all, 8);
+    vr = _mm256_loadu_pd(values_real + k + 4);
+    vi = _mm256_loadu_pd(values_imag + k + 4);
+    real_high = _mm256_fnmadd_pd(vi, xi, _mm256_fmadd_pd(vr, xr, real_high));
+    imag_high = _mm256_fmadd_pd(vi, xr, _mm256_fmadd_pd(vr, xi, imag_high));
+  }
+  _mm256_storeu_pd(real, real_low);
+  _mm256_storeu_pd(real + 4, real_high);
+  _mm256_storeu_pd(imag, imag_low);
+  _mm256_storeu_pd(imag + 4, imag_high);
+}
+
+__attribute__((target("avx512f"))) void chunk_avx512(
+    std::size_t width, const std::int32_t* columns, const double* values_real,
+    const double* values_imag, const double* x, double* real, double* imag) {
+  const __m512d zero = _mm512_setzero_pd();
+  __m512d sum_real = _mm512_setzero_pd();
+  __m512d sum_imag = _mm512_setzero_pd();
+  for (std::size_t j = 0; j < width; j++) {
+    const std::size_t k = j * C;
+    const __m256i index =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i*>(columns + k));
+    const __m512d xr = _mm512_mask_i32gather_pd(zero, 0xff, index, x, 8);
+    const __m512d xi = _mm512_mask_i32gather_pd(zero, 0xff, index, x + 1, 8);
+    const __m512d vr = _mm512_loadu_pd(values_real + k);
+    const __m512d vi = _mm512_loadu_pd(values_imag + k);
+    sum_real = _mm512_fnmadd_pd(vi, xi, _mm512_fmadd_pd(vr, xr, sum_real));
+    sum_imag = _mm512_fmadd_pd(vi, xr, _mm512_fmadd_pd(vr, xi, sum_imag));
+  }
+  _mm512_storeu_pd(real, sum_real);
+  _mm512_storeu_pd(imag, sum_imag);
+}
+
+#endif
+
+}  // namespace
+
+SellMatrix::SellMatrix(const CsrMatrix<Complex>& matrix, std::size_t sigma)
+    : m_rows{matrix.rows()},
+      m_cols{matrix.cols()},
+      m_nonzeros{matrix.nonzeros()},
+      m_kernel{best_kernel()} {
+  LIBMB_ASSERT(sigma % C == 0);
+  LIBMB_ASSERT(
+      m_cols <= std::size_t{std::numeric_limits<std::int32_t>::max()} / 2);
+  const auto& offsets = matrix.row_offsets();
+  auto length = [&](std::size_t r) { return offsets[r + 1] - offsets[r]; };
+
+  // Sort the rows by decreasing length within each window of sigma rows.
+  m_permutation.resize(m_rows);
+  std::iota(m_permutation.begin(), m_permutation.end(), std::size_t{0});
+  for (std::size_t first = 0; first < m_rows; first += sigma) {
+    const std::size_t last = std::min(m_rows, first + sigma);
+    std::stable_sort(
+        m_permutation.begin() + static_cast<std::ptrdiff_t>(first),
+        m_permutation.begin() + static_cast<std::ptrdiff_t>(last),
+        [&](std::size_t a, std::size_t b) { return length(a) > length(b); });
+  }
+
+  const std::size_t chunks = (m_rows + C - 1) / C;
+  m_chunk_offsets.assign(chunks + 1, 0);
+  for (std::size_t c = 0; c < chunks; c++) {
+    // The first row of a chunk is its longest.
+    m_chunk_offsets[c + 1] =
+        m_chunk_offsets[c] + length(m_permutation[c * C]);
+  }
+
+  const std::size_t stored = C * m_chunk_offsets[chunks];
+  m_columns.assign(stored, 0);
+  m_real.assign(stored, 0.0);
+  m_imag.assign(stored, 0.0);
+#pragma omp parallel for schedule(static)
+  for (std::size_t c = 0; c < chunks; c++) {
+    const std::size_t base = C * m_chunk_offsets[c];
+    for (std::size_t lane = 0; lane < C && c * C + lane < m_rows; lane++) {
+      const std::size_t r = m_permutation[c * C + lane];
+      for (std::size_t j = 0; j < length(r); j++) {
+        const std::size_t k = offsets[r] + j;
+        const std::size_t position = base + j * C + lane;
+        m_columns[position] =
+            static_cast<std::int32_t>(2 * matrix.columns()[k]);
+        m_real[position] = matrix.values()[k].real();
+        m_imag[position] = matrix.values()[k].imag();
+      }
+    }
+  }
+}
+
+SellMatrix::Kernel SellMatrix::best_kernel() {
+#ifdef LIBMB_HAS_X86_KERNELS
+  if (__builtin_cpu_supports("avx512f")) {
+    return Kernel::Avx512;
+  }
+  if (__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma")) {
+    return Kernel::Avx2;
+  }
+#endif
+  return Kernel::Scalar;
+}
+
+void SellMatrix::multiply(
+    const std::vector<Complex>& x, std::vector<Complex>& y,
+    Kernel kernel) const {
+  LIBMB_ASSERT(x.size() >= m_cols && y.size() >= m_rows);
+  LIBMB_ASSERT(kernel <= best_kernel());
+  ChunkKernel chunk_kernel = chunk_scalar;
+#ifdef LIBMB_HAS_X86_KERNELS
+  if (kernel == Kernel::Avx512) {
+    chunk_kernel = chunk_avx512;
+  } else if (kernel == Kernel::Avx2) {
+    chunk_kernel = chunk_avx2;
+  }
+#endif
+
+  // std::complex<double> is laid out as two doubles.
+  const double* x_data = reinterpret_cast<const double*>(x.data());
+  const std::size_t chunks = m_chunk_offsets.size() - 1;
+#pragma omp parallel for schedule(dynamic, 16)
+  for (std::size_t c = 0; c < chunks; c++) {
+    double real[C];
+    double imag[C];
+    const std::size_t base = C * m_chunk_offsets[c];
+    chunk_kernel(
+        m_chunk_offsets[c + 1] - m_chunk_offsets[c], m_columns.data() + base,
+        m_real.data() + base, m_imag.data() + base, x_data, real, imag);
+    for (std::size_t lane = 0; lane < C && c * C + lane < m_rows; lane++) {
+      y[m_permutation[c * C + lane]] = {real[lane], imag[lane]};
+    }
+  }
+}
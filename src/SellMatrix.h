@@ -0,0 +1,73 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include <complex>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "CsrMatrix.h"
+
+// Sliced ELLPACK (SELL-C-sigma) storage of a complex matrix, laid out for
+// SIMD products. Rows are grouped in chunks of C = 8 and every chunk is
+// stored column-major, padded to the length of its longest row, so that each
+// vector lane handles one row. To keep the padding small, rows are sorted by
+// length within windows of sigma rows first. Real and imaginary parts live in
+// separate arrays, which turns complex products into plain multiply-adds.
+//
+// The product uses AVX-512 or AVX2 kernels when the processor supports them
+// and a scalar loop otherwise.
+class SellMatrix {
+ public:
+  using Complex = std::complex<double>;
+
+  enum class Kernel { Scalar, Avx2, Avx512 };
+
+  static constexpr std::size_t chunk_size = 8;
+
+  explicit SellMatrix(
+      const CsrMatrix<Complex>& matrix, std::size_t sigma = 256);
+
+  std::size_t rows() const { return m_rows; }
+
+  std::size_t cols() const { return m_cols; }
+
+  std::size_t nonzeros() const { return m_nonzeros; }
+
+  // Number of stored elements, padding included.
+  std::size_t stored() const { return m_real.size(); }
+
+  // The fastest kernel the processor supports.
+  static Kernel best_kernel();
+
+  // y = A x.
+  void multiply(const std::vector<Complex>& x, std::vector<Complex>& y) const {
+    multiply(x, y, m_kernel);
+  }
+
+  // y = A x, with a given kernel, which must be supported by the processor.
+  void multiply(
+      const std::vector<Complex>& x, std::vector<Complex>& y,
+      Kernel kernel) const;
+
+ private:
+  std::size_t m_rows;
+  std::size_t m_cols;
+  std::size_t m_nonzeros = 0;
+  Kernel m_kernel;
+
+  // Chunk c occupies positions chunk_size * m_chunk_offsets[c] onwards, and
+  // has width m_chunk_offsets[c + 1] - m_chunk_offsets[c].
+  std::vector<std::size_t> m_chunk_offsets;
+
+  // Offsets of the real part of x[column] in the array of doubles, i.e.
+  // 2 * column.
+  std::vector<std::int32_t> m_columns;
+  std::vector<double> m_real;
+  std::vector<double> m_imag;
+
+  // Original row of every sorted row.
+  std::vector<std::size_t> m_permutation;
+};
@@ -0,0 +1,113 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "SeparableMatrix.h"
+
+#include <algorithm>
+#include <iterator>
+
+#include "CompiledExpression.h"
+
+namespace {
+
+// Sorted union of the columns of row `r` of all the parts.
+void merge_columns(
+    const std::vector<CsrMatrix<Term::CoeffType>>& parts, std::size_t r,
+    std::vector<std::size_t>& merged, std::vector<std::size_t>& scratch) {
+  merged.clear();
+  for (const auto& part : parts) {
+    auto first = part.columns().begin() +
+                 static_cast<std::ptrdiff_t>(part.row_offsets()[r]);
+    auto last = part.columns().begin() +
+                static_cast<std::ptrdiff_t>(part.row_offsets()[r + 1]);
+    scratch.clear();
+    std::set_union(
+        merged.begin(), merged.end(), first, last, std::back_inserter(scratch));
+    std::swap(merged, scratch);
+  }
+}
+
+}  // namespace
+
+SeparableMatrix::SeparableMatrix(const Model& model, const Basis& basis)
+    : m_size{basis.size()} {
+  for (const HamiltonianPart& part : model.hamiltonian_parts()) {
+    m_names.push_back(part.name);
+    m_parts.push_back(CompiledExpression(part.terms).matrix(basis));
+  }
+
+  // Merge the columns of every row, counting first and filling afterwards.
+  m_row_offsets.assign(m_size + 1, 0);
+#pragma omp parallel
+  {
+    std::vector<std::size_t> merged;
+    std::vector<std::size_t> scratch;
+#pragma omp for schedule(dynamic, 256)
+    for (std::size_t r = 0; r < m_size; r++) {
+      merge_columns(m_parts, r, merged, scratch);
+      m_row_offsets[r + 1] = merged.size();
+    }
+  }
+  for (std::size_t r = 0; r < m_size; r++) {
+    m_row_offsets[r + 1] += m_row_offsets[r];
+  }
+
+  m_columns.assign(m_row_offsets[m_size], 0);
+  m_positions.resize(m_parts.size());
+  for (std::size_t k = 0; k < m_parts.size(); k++) {
+    m_positions[k].resize(m_parts[k].nonzeros());
+  }
+#pragma omp parallel
+  {
+    std::vector<std::size_t> merged;
+    std::vector<std::size_t> scratch;
+#pragma omp for schedule(dynamic, 256)
+    for (std::size_t r = 0; r < m_size; r++) {
+      merge_columns(m_parts, r, merged, scratch);
+      std::copy(
+          merged.begin(), merged.end(),
+          m_columns.begin() + static_cast<std::ptrdiff_t>(m_row_offsets[r]));
+
+      for (std::size_t k = 0; k < m_parts.size(); k++) {
+        const auto& part = m_parts[k];
+        for (std::size_t e = part.row_offsets()[r];
+             e < part.row_offsets()[r + 1]; e++) {
+          auto it = std::lower_bound(
+              merged.begin(), merged.end(), part.columns()[e]);
+          m_positions[k][e] =
+              m_row_offsets[r] +
+              static_cast<std::size_t>(std::distance(merged.begin(), it));
+        }
+      }
+    }
+  }
+}
+
+std::vector<SeparableMatrix::CoeffType> SeparableMatrix::coefficients(
+    const Model& model) const {
+  std::vector<CoeffType> result;
+  for (const HamiltonianPart& part : model.hamiltonian_parts()) {
+    LIBMB_ASSERT(
+        result.size() < m_names.size() && m_names[result.size()] == part.name);
+    result.push_back(part.coefficient);
+  }
+  LIBMB_ASSERT(result.size() == m_names.size());
+  return result;
+}
+
+CsrMatrix<SeparableMatrix::CoeffType> SeparableMatrix::assemble(
+    const std::vector<CoeffType>& coefficients) const {
+  LIBMB_ASSERT(coefficients.size() == m_parts.size());
+  std::vector<CoeffType> values(m_columns.size());
+#pragma omp parallel for schedule(dynamic, 256)
+  for (std::size_t r = 0; r < m_size; r++) {
+    for (std::size_t k = 0; k < m_parts.size(); k++) {
+      const auto& part = m_parts[k];
+      for (std::size_t e = part.row_offsets()[r]; e < part.row_offsets()[r + 1];
+           e++) {
+        values[m_positions[k][e]] += coefficients[k] * part.values()[e];
+      }
+    }
+  }
+  return CsrMatrix<CoeffType>(m_size, m_row_offsets, m_columns, values);
+}
@@ -0,0 +1,75 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#include "Basis.h"
+#include "CsrMatrix.h"
+#include "Model.h"
+
+// The matrix of a Hamiltonian H = sum_k c_k H_k in a fixed basis, with each
+// part H_k assembled once. The union of the sparsity patterns of the parts is
+// also computed once, so the matrix for a new set of coefficients is just a
+// scaled sum of the stored values, and H x can be computed without assembling
+// H at all. Sweeping over model parameters then costs about as much as a
+// single assembly.
+class SeparableMatrix {
+ public:
+  using CoeffType = Term::CoeffType;
+
+  SeparableMatrix(const Model& model, const Basis& basis);
+
+  std::size_t size() const { return m_size; }
+
+  const std::vector<std::string>& names() const { return m_names; }
+
+  // The coefficients of the parts of `model`, which must be split in the same
+  // way as the model this matrix was built from.
+  std::vector<CoeffType> coefficients(const Model& model) const;
+
+  const CsrMatrix<CoeffType>& part(std::size_t k) const { return m_parts[k]; }
+
+  CsrMatrix<CoeffType> assemble(
+      const std::vector<CoeffType>& coefficients) const;
+
+  CsrMatrix<CoeffType> assemble(const Model& model) const {
+    return assemble(coefficients(model));
+  }
+
+  // y = (sum_k c_k H_k) x, in a single pass over the parts.
+  template <typename Vec>
+  void multiply(
+      const std::vector<CoeffType>& coefficients, const Vec& x, Vec& y) const {
+    LIBMB_ASSERT(coefficients.size() == m_parts.size());
+#pragma omp parallel for schedule(dynamic, 256)
+    for (std::size_t r = 0; r < m_size; r++) {
+      CoeffType sum{};
+      for (std::size_t k = 0; k < m_parts.size(); k++) {
+        const auto& offsets = m_parts[k].row_offsets();
+        const auto& columns = m_parts[k].columns();
+        const auto& values = m_parts[k].values();
+        CoeffType part_sum{};
+        for (std::size_t e = offsets[r]; e < offsets[r + 1]; e++) {
+          part_sum += values[e] * x[columns[e]];
+        }
+        sum += coefficients[k] * part_sum;
+      }
+      y[r] = sum;
+    }
+  }
+
+ private:
+  std::size_t m_size;
+  std::vector<std::string> m_names;
+  std::vector<CsrMatrix<CoeffType>> m_parts;
+
+  // Union pattern of the parts, and the position in it of every entry of
+  // every part.
+  std::vector<std::size_t> m_row_offsets;
+  std::vector<std::size_t> m_columns;
+  std::vector<std::vector<std::size_t>> m_positions;
+};
@@ -0,0 +1,39 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "StateVector.h"
+
+#include <algorithm>
+#include <numeric>
+
+StateVector StateVector::basis_state(const Basis& basis, std::size_t index) {
+  LIBMB_ASSERT(index < basis.size());
+  StateVector result(basis);
+  result[index] = 1.0;
+  return result;
+}
+
+StateVector StateVector::apply(
+    const CompiledExpression& op, const Basis& target) const {
+  StateVector result(target);
+  op.apply(*m_basis, m_amplitudes, target, result.m_amplitudes);
+  return result;
+}
+
+std::vector<Term> StateVector::dominant_terms(std::size_t count) const {
+  count = std::min(count, size());
+  std::vector<std::size_t> order(size());
+  std::iota(order.begin(), order.end(), std::size_t{0});
+  std::partial_sort(
+      order.begin(), order.begin() + static_cast<std::ptrdiff_t>(count),
+      order.end(), [&](std::size_t a, std::size_t b) {
+        return std::abs(m_amplitudes[a]) > std::abs(m_amplitudes[b]);
+      });
+
+  std::vector<Term> result;
+  result.reserve(count);
+  for (std::size_t k = 0; k < count; k++) {
+    result.emplace_back(m_amplitudes[order[k]], m_basis->element(order[k]));
+  }
+  return result;
+}
@@ -0,0 +1,93 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+#include "Assert.h"
+#include "Basis.h"
+#include "CompiledExpression.h"
+#include "Expression.h"
+#include "LinearAlgebra.h"
+#include "Term.h"
+
+// A many-body state, sum_i amplitude_i |basis element i>. The amplitudes are
+// stored contiguously, as the ComplexVector used by the solvers, so that
+// states are passed to them and back without copies. The basis is referred
+// to, not owned, and must outlive the state.
+//
+// Every operation is parallelised with OpenMP.
+class StateVector {
+ public:
+  explicit StateVector(const Basis& basis)
+      : m_basis{&basis}, m_amplitudes(basis.size()) {}
+
+  StateVector(const Basis& basis, ComplexVector amplitudes)
+      : m_basis{&basis}, m_amplitudes{std::move(amplitudes)} {
+    LIBMB_ASSERT(m_amplitudes.size() == basis.size());
+  }
+
+  // The basis state with index `index`.
+  static StateVector basis_state(const Basis& basis, std::size_t index);
+
+  const Basis& basis() const { return *m_basis; }
+
+  std::size_t size() const { return m_amplitudes.size(); }
+
+  Complex& operator[](std::size_t i) { return m_amplitudes[i]; }
+
+  const Complex& operator[](std::size_t i) const { return m_amplitudes[i]; }
+
+  const ComplexVector& amplitudes() const { return m_amplitudes; }
+
+  ComplexVector& amplitudes() { return m_amplitudes; }
+
+  double norm() const { return ::norm(m_amplitudes); }
+
+  void normalize() { ::scale(1.0 / norm(), m_amplitudes); }
+
+  // <this|other>, for states in the same basis.
+  Complex overlap(const StateVector& other) const {
+    LIBMB_ASSERT(m_basis == other.m_basis);
+    return dot(m_amplitudes, other.m_amplitudes);
+  }
+
+  // this += a x, for states in the same basis.
+  void axpy(Complex a, const StateVector& x) {
+    LIBMB_ASSERT(m_basis == x.m_basis);
+    ::axpy(a, x.m_amplitudes, m_amplitudes);
+  }
+
+  void scale(Complex a) { ::scale(a, m_amplitudes); }
+
+  // O|this>, expressed in `target`; components outside of it are dropped.
+  // `target` may be the basis of the state, or e.g. the sector with one more
+  // particle for a creation operator.
+  StateVector apply(const CompiledExpression& op, const Basis& target) const;
+
+  StateVector apply(const Expression& op, const Basis& target) const {
+    return apply(CompiledExpression(op), target);
+  }
+
+  StateVector apply(const Expression& op) const { return apply(op, *m_basis); }
+
+  // <this|O|this>.
+  Complex expectation(const CompiledExpression& op) const {
+    return op.expectation(*m_basis, m_amplitudes);
+  }
+
+  Complex expectation(const Expression& op) const {
+    return expectation(CompiledExpression(op));
+  }
+
+  // The `count` components of largest magnitude, in decreasing order, as
+  // terms whose operators are the basis elements.
+  std::vector<Term> dominant_terms(std::size_t count) const;
+
+ private:
+  const Basis* m_basis;
+  ComplexVector m_amplitudes;
+};
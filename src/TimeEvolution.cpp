@@ -0,0 +1,103 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "TimeEvolution.h"
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "Assert.h"
+
+namespace {
+
+// exp(-i T dt) e_1 for the tridiagonal T with eigendecomposition `eigen`.
+ComplexVector exponential(const TridiagonalEigen& eigen, double dt) {
+  const std::size_t m = eigen.values.size();
+  ComplexVector result(m);
+  for (std::size_t l = 0; l < m; l++) {
+    const Complex phase =
+        eigen.vectors[l * m] * std::polar(1.0, -eigen.values[l] * dt);
+    for (std::size_t j = 0; j < m; j++) {
+      result[j] += eigen.vectors[j + l * m] * phase;
+    }
+  }
+  return result;
+}
+
+}  // namespace
+
+TimeEvolutionResult evolve(
+    const LinearOperator& op, ComplexVector& psi, double time,
+    const TimeEvolutionOptions& options) {
+  LIBMB_ASSERT(psi.size() == op.size());
+  LIBMB_ASSERT(
+      options.krylov_dimension >= TimeEvolutionOptions::min_krylov_dimension);
+  TimeEvolutionResult result;
+  const double state_norm = norm(psi);
+  if (state_norm == 0.0) {
+    return result;
+  }
+
+  const double direction = time < 0.0 ? -1.0 : 1.0;
+  double remaining = std::abs(time);
+  std::vector<ComplexVector> krylov;
+  while (remaining > 0.0) {
+    // Lanczos on psi, reorthogonalised against the whole (short) basis.
+    std::vector<double> alpha;
+    std::vector<double> beta;
+    krylov.assign(1, psi);
+    scale(1.0 / state_norm, krylov[0]);
+    double next_beta = 0.0;
+    for (std::size_t j = 0; j < options.krylov_dimension; j++) {
+      ComplexVector w;
+      op.apply(krylov[j], w);
+      result.applications++;
+      alpha.push_back(dot(krylov[j], w).real());
+      for (std::size_t pass = 0; pass < 2; pass++) {
+        for (const auto& v : krylov) {
+          axpy(-dot(v, w), v, w);
+        }
+      }
+      next_beta = norm(w);
+      // An invariant subspace makes the step exact.
+      if (next_beta <= 1e-12 * std::max(1.0, std::abs(alpha.back()))) {
+        next_beta = 0.0;
+        break;
+      }
+      if (j + 1 == options.krylov_dimension) {
+        break;
+      }
+      beta.push_back(next_beta);
+      scale(1.0 / next_beta, w);
+      krylov.push_back(std::move(w));
+    }
+
+    const TridiagonalEigen eigen = tridiagonal_eigen(alpha, beta);
+    if (!eigen.converged) {
+      result.completed = false;
+      break;
+    }
+    double dt = remaining;
+    ComplexVector coefficients = exponential(eigen, direction * dt);
+    double error = next_beta * std::abs(coefficients.back()) * state_norm;
+    while (error > options.tolerance * state_norm) {
+      dt *= 0.5;
+      coefficients = exponential(eigen, direction * dt);
+      error = next_beta * std::abs(coefficients.back()) * state_norm;
+    }
+    if (dt < remaining && remaining - dt == remaining) {
+      result.completed = false;
+      break;
+    }
+
+    std::fill(psi.begin(), psi.end(), Complex{});
+    for (std::size_t j = 0; j < krylov.size(); j++) {
+      axpy(state_norm * coefficients[j], krylov[j], psi);
+    }
+    result.error += error;
+    result.steps++;
+    remaining = dt < remaining ? remaining - dt : 0.0;
+  }
+  return result;
+}
@@ -0,0 +1,42 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include <cstddef>
+
+#include "LinearOperator.h"
+
+struct TimeEvolutionOptions {
+  // Smallest Krylov space evolve() accepts. The error of a step only falls
+  // like dt^(m - 1), so smaller spaces need impractically short steps.
+  static constexpr std::size_t min_krylov_dimension = 4;
+
+  // Largest Krylov space built for a single step, at least
+  // min_krylov_dimension.
+  std::size_t krylov_dimension = 30;
+  // Error allowed per step, relative to the norm of the state.
+  double tolerance = 1e-10;
+};
+
+struct TimeEvolutionResult {
+  // False if the steps became too short to advance the time, or the
+  // projected matrix could not be diagonalised, in which case psi is the
+  // state at the last time reached.
+  bool completed = true;
+  // Estimate of the norm of the accumulated error of the state.
+  double error = 0.0;
+  std::size_t steps = 0;
+  // Number of vectors the operator was applied to.
+  std::size_t applications = 0;
+};
+
+// psi <- exp(-i H t) psi by short-iteration Lanczos. Every step builds a
+// Krylov space of psi and exponentiates the projected tridiagonal matrix.
+// The length of the step is the largest (up to what remains of t) whose
+// estimated error, beta_m |[exp(-i T_m dt) e_1]_m|, is within the tolerance;
+// since the Krylov space does not depend on it, it is chosen without further
+// products. Negative t evolves backwards.
+TimeEvolutionResult evolve(
+    const LinearOperator& op, ComplexVector& psi, double time,
+    const TimeEvolutionOptions& options = {});
@@ -97,6 +97,73 @@ TEST(BasisTest, BasisGenerationDisallowingDoubleOccupation) {
           std::vector<Operator>{Operator::creation<Fermion>(Up, 1)}));
 }
 
+TEST(BasisTest, BasisGenerationCanonicalOrder) {
+  FermionicBasis basis(2, 2, /*allow_double_occupancy=*/true);
+  EXPECT_THAT(
+      basis.elements(),
+      ElementsAre(
+          std::vector<Operator>{
+              Operator::creation<Fermion>(Up, 0),
+              Operator::creation<Fermion>(Down, 0)},
+          std::vector<Operator>{
+              Operator::creation<Fermion>(Up, 0),
+              Operator::creation<Fermion>(Up, 1)},
+          std::vector<Operator>{
+              Operator::creation<Fermion>(Up, 0),
+              Operator::creation<Fermion>(Down, 1)},
+          std::vector<Operator>{
+              Operator::creation<Fermion>(Down, 0),
+              Operator::creation<Fermion>(Up, 1)},
+          std::vector<Operator>{
+              Operator::creation<Fermion>(Down, 0),
+              Operator::creation<Fermion>(Down, 1)},
+          std::vector<Operator>{
+              Operator::creation<Fermion>(Up, 1),
+              Operator::creation<Fermion>(Down, 1)}));
+}
+
+static bool identifier_less(const BasisElement& a, const BasisElement& b) {
+  return std::lexicographical_compare(
+      a.begin(), a.end(), b.begin(), b.end(),
+      [](const Operator& x, const Operator& y) {
+        return x.identifier() < y.identifier();
+      });
+}
+
+class EvenOrbitalSumFilter : public BasisFilter {
+ public:
+  bool filter(const BasisElement& element) const override {
+    std::size_t sum = 0;
+    for (const auto& op : element) {
+      sum += op.orbital();
+    }
+    return sum % 2 == 0;
+  }
+};
+
+TEST(BasisTest, LargeBasisGenerationIsOrderedAndIndexed) {
+  FermionicBasis fermionic(8, 4, /*allow_double_occupancy=*/true);
+  FermionicBasis filtered(8, 4, new EvenOrbitalSumFilter);
+  FermionicBasis single(8, 4, /*allow_double_occupancy=*/false);
+  BosonicBasis bosonic(6, 4);
+  GenericBasis generic(5, 3);
+
+  EXPECT_EQ(fermionic.size(), binomial(16, 4));
+  EXPECT_EQ(bosonic.size(), binomial(9, 4));
+  EXPECT_EQ(generic.size(), binomial(8, 3));
+
+  for (const Basis* basis : std::vector<const Basis*>{
+           &fermionic, &filtered, &single, &bosonic, &generic}) {
+    for (std::size_t i = 0; i < basis->size(); i++) {
+      EXPECT_EQ(basis->index(basis->element(i)), i);
+      if (i > 0) {
+        EXPECT_TRUE(
+            identifier_less(basis->element(i - 1), basis->element(i)));
+      }
+    }
+  }
+}
+
 TEST(BasisTest, IndexingUnique) {
   FermionicBasis basis(2, 2, /*allow_double_occupancy=*/true);
 
@@ -0,0 +1,55 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "BasisOrdering.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include "FermionicBasis.h"
+#include "Models/HubbardChain.h"
+
+using testing::UnorderedElementsAreArray;
+
+TEST(BasisOrderingTest, PathGraph) {
+  // A path 0 - 3 - 1 - 4 - 2 labeled out of order.
+  BasisGraph graph = {{3}, {3, 4}, {4}, {0, 1}, {1, 2}};
+  EXPECT_EQ(bandwidth(graph), 3);
+
+  std::vector<std::size_t> order = reverse_cuthill_mckee(graph);
+  EXPECT_THAT(order, UnorderedElementsAreArray({0, 1, 2, 3, 4}));
+
+  std::vector<std::size_t> position(order.size());
+  for (std::size_t k = 0; k < order.size(); k++) {
+    position[order[k]] = k;
+  }
+  EXPECT_EQ(bandwidth(graph, position), 1);
+}
+
+TEST(BasisOrderingTest, DisconnectedGraph) {
+  BasisGraph graph = {{2}, {}, {0}, {4}, {3}};
+  std::vector<std::size_t> order = reverse_cuthill_mckee(graph);
+  EXPECT_THAT(order, UnorderedElementsAreArray({0, 1, 2, 3, 4}));
+}
+
+TEST(BasisOrderingTest, ReorderHubbardChainBasis) {
+  HubbardChain model(1.0, 4.0, 6);
+  FermionicBasis basis(6, 4);
+  const std::vector<BasisElement> original = basis.elements();
+
+  SparseMatrix<std::complex<double>> before;
+  model.compute_matrix_elements(basis, before);
+  BandwidthReport report = reorder_reverse_cuthill_mckee(basis, before);
+
+  EXPECT_EQ(report.before, bandwidth(basis_graph(before, basis.size())));
+  EXPECT_LT(report.after, report.before);
+  EXPECT_THAT(basis.elements(), UnorderedElementsAreArray(original));
+  for (std::size_t i = 0; i < basis.size(); i++) {
+    EXPECT_EQ(basis.index(basis.element(i)), i);
+  }
+
+  SparseMatrix<std::complex<double>> after;
+  model.compute_matrix_elements(basis, after);
+  EXPECT_EQ(after.size(), before.size());
+  EXPECT_EQ(bandwidth(basis_graph(after, basis.size())), report.after);
+}
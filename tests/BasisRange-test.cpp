@@ -0,0 +1,87 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "BasisRange.h"
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+
+#include <ranges>
+
+#include "BosonicBasis.h"
+#include "FermionicBasis.h"
+
+using enum Operator::Statistics;
+using enum Operator::Spin;
+
+static_assert(std::ranges::input_range<FermionicBasisRange>);
+static_assert(std::ranges::input_range<BosonicBasisRange>);
+
+static std::vector<BasisElement> collect(const BasisRange& range) {
+  std::vector<BasisElement> result;
+  for (const auto& element : range) {
+    result.push_back(element);
+  }
+  return result;
+}
+
+class TotalSpinFilter : public BasisFilter {
+ public:
+  explicit TotalSpinFilter(int spin) : m_spin(spin) {}
+
+  bool filter(const BasisElement& element) const override {
+    int total_spin = 0;
+    for (const auto& op : element) {
+      total_spin += op.spin() == Up ? 1 : -1;
+    }
+    return total_spin == m_spin;
+  }
+
+ private:
+  int m_spin;
+};
+
+TEST(BasisRangeTest, FermionicMatchesBasis) {
+  for (std::size_t orbs = 0; orbs < 6; orbs++) {
+    for (std::size_t parts = 0; parts < 6; parts++) {
+      for (bool double_occupancy : {true, false}) {
+        FermionicBasis basis(orbs, parts, double_occupancy);
+        FermionicBasisRange range(orbs, parts, double_occupancy);
+        EXPECT_EQ(collect(range), basis.elements());
+      }
+    }
+  }
+}
+
+TEST(BasisRangeTest, FermionicWithFilterMatchesBasis) {
+  FermionicBasis basis(6, 4, new TotalSpinFilter(0));
+  FermionicBasisRange range(6, 4, new TotalSpinFilter(0));
+  EXPECT_EQ(collect(range), basis.elements());
+
+  FermionicBasis single(6, 3, new TotalSpinFilter(1), false);
+  FermionicBasisRange single_range(6, 3, new TotalSpinFilter(1), false);
+  EXPECT_EQ(collect(single_range), single.elements());
+}
+
+TEST(BasisRangeTest, BosonicMatchesBasis) {
+  for (std::size_t orbs = 0; orbs < 6; orbs++) {
+    for (std::size_t parts = 0; parts < 6; parts++) {
+      BosonicBasis basis(orbs, parts);
+      BosonicBasisRange range(orbs, parts);
+      EXPECT_EQ(collect(range), basis.elements());
+    }
+  }
+}
+
+TEST(BasisRangeTest, EmptyWhenEverythingIsFiltered) {
+  FermionicBasisRange range(4, 3, new TotalSpinFilter(0));
+  EXPECT_TRUE(range.begin() == range.end());
+}
+
+TEST(BasisRangeTest, WorksWithRangeAlgorithms) {
+  FermionicBasisRange range(4, 2);
+  auto count = std::ranges::count_if(range, [](const BasisElement& element) {
+    return element.front().orbital() == element.back().orbital();
+  });
+  EXPECT_EQ(count, 4);
+}
@@ -0,0 +1,71 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "BlockLanczos.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "FermionicBasis.h"
+#include "Models/HubbardChain.h"
+#include "TestHelpers.h"
+
+TEST(BlockLanczosTest, BlockProducts) {
+  HubbardChain model(1.0, 4.0, 4);
+  FermionicBasis basis(4, 4);
+  const CsrMatrix<Complex> matrix = model.matrix(basis);
+  const std::size_t n = basis.size();
+  const std::size_t k = 3;
+  std::mt19937_64 rng(2);
+  const ComplexVector x = random_vector(n * k, rng);
+
+  ComplexVector from_matrix(n * k);
+  ComplexVector from_model(n * k);
+  matrix.multiply_block(x, from_matrix, k);
+  model.apply_block(basis, x, from_model, k);
+  for (std::size_t j = 0; j < k; j++) {
+    const ComplexVector column = block_column(x, k, j);
+    ComplexVector expected(n);
+    matrix.multiply(column, expected);
+    for (std::size_t i = 0; i < n; i++) {
+      EXPECT_NEAR(std::abs(from_matrix[i * k + j] - expected[i]), 0.0, 1e-12);
+      EXPECT_NEAR(std::abs(from_model[i * k + j] - expected[i]), 0.0, 1e-12);
+    }
+  }
+}
+
+TEST(BlockLanczosTest, HubbardChain) {
+  // Without a fixed S^z, the spectrum has degenerate spin multiplets, which
+  // a block of four vectors resolves.
+  HubbardChain model(1.0, 4.0, 5);
+  FermionicBasis basis(5, 5);
+  const std::vector<double> expected = dense_eigenvalues(model, basis);
+
+  BlockLanczosOptions options;
+  options.roots = 4;
+  const CsrMatrix<Complex> matrix = model.matrix(basis);
+  LinearOperator assembled(matrix);
+  expect_eigenpairs(
+      assembled, block_lanczos(assembled, options), expected, options.roots);
+
+  LinearOperator matrix_free(model, basis);
+  expect_eigenpairs(
+      matrix_free, block_lanczos(matrix_free, options), expected,
+      options.roots);
+}
+
+TEST(BlockLanczosTest, ThickRestart) {
+  HubbardChain model(1.0, 4.0, 5);
+  FermionicBasis basis(5, 5);
+  const std::vector<double> expected = dense_eigenvalues(model, basis);
+
+  BlockLanczosOptions options;
+  options.roots = 2;
+  options.block_size = 3;
+  options.max_basis = 15;
+  LinearOperator op(model, basis);
+  EigenResult result = block_lanczos(op, options);
+  EXPECT_GT(result.restarts, 0);
+  expect_eigenpairs(op, result, expected, options.roots);
+}
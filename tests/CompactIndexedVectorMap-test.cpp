@@ -0,0 +1,83 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "CompactIndexedVectorMap.h"
+
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+
+#include "Operator.h"
+
+TEST(CompactIndexedVectorMapTest, InsertAndLookup) {
+  CompactIndexedVectorMap<int> map;
+  EXPECT_EQ(map.size(), 0);
+  EXPECT_FALSE(map.contains(1));
+
+  for (int i = 0; i < 1000; i++) {
+    map.insert(3 * i);
+  }
+
+  EXPECT_EQ(map.size(), 1000);
+  for (std::size_t i = 0; i < 1000; i++) {
+    int value = 3 * static_cast<int>(i);
+    EXPECT_TRUE(map.contains(value));
+    EXPECT_FALSE(map.contains(value + 1));
+    EXPECT_EQ(map.index(value), i);
+    EXPECT_EQ(map[i], value);
+  }
+}
+
+TEST(CompactIndexedVectorMapTest, MissingElementThrows) {
+  CompactIndexedVectorMap<int> map;
+  EXPECT_THROW(map.index(0), std::out_of_range);
+  map.insert(0);
+  EXPECT_THROW(map.index(1), std::out_of_range);
+}
+
+TEST(CompactIndexedVectorMapTest, Reserve) {
+  CompactIndexedVectorMap<int, std::uint64_t> map;
+  map.reserve(100);
+  for (int i = 0; i < 100; i++) {
+    map.insert(i);
+  }
+  for (int i = 0; i < 100; i++) {
+    EXPECT_EQ(map.index(i), i);
+  }
+}
+
+TEST(CompactIndexedVectorMapTest, Sort) {
+  CompactIndexedVectorMap<std::vector<Operator>> map;
+  for (std::size_t i = 0; i < 32; i++) {
+    map.insert({Operator::creation<Operator::Statistics::Fermion>(
+        Operator::Spin::Up, i)});
+  }
+
+  map.sort([](const auto& a, const auto& b) {
+    return a.front().orbital() > b.front().orbital();
+  });
+
+  for (std::size_t i = 0; i < map.size(); i++) {
+    EXPECT_EQ(map[i].front().orbital(), 31 - i);
+    EXPECT_EQ(map.index(map[i]), i);
+  }
+}
+
+TEST(CompactIndexedVectorMapTest, SortLarge) {
+  CompactIndexedVectorMap<int> map;
+  const int size = 100000;
+  for (int i = 0; i < size; i++) {
+    map.insert(i);
+  }
+
+  map.sort([](int a, int b) {
+    return a % 7 < b % 7 || (a % 7 == b % 7 && a > b);
+  });
+
+  for (std::size_t i = 0; i < map.size(); i++) {
+    EXPECT_EQ(map.index(map[i]), i);
+    if (i > 0) {
+      EXPECT_LE(map[i - 1] % 7, map[i] % 7);
+    }
+  }
+}
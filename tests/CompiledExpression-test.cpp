@@ -0,0 +1,362 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "CompiledExpression.h"
+
+#include <gtest/gtest.h>
+
+#include <map>
+#include <utility>
+
+#include "BosonicBasis.h"
+#include "FermionicBasis.h"
+#include "Models/HubbardChain.h"
+#include "NormalOrder.h"
+#include "SparseMatrix.h"
+
+namespace {
+
+constexpr auto Fermion = Operator::Statistics::Fermion;
+constexpr auto Boson = Operator::Statistics::Boson;
+constexpr auto Up = Operator::Spin::Up;
+constexpr auto Down = Operator::Spin::Down;
+
+using Elements = std::map<std::pair<std::size_t, std::size_t>, Term::CoeffType>;
+
+// <r|O|c> computed by normal ordering O^dagger |r> term by term.
+Elements reference_elements(
+    const std::vector<Term>& terms, const Basis& row_basis,
+    const Basis& column_basis) {
+  Elements result;
+  for (std::size_t r = 0; r < row_basis.size(); r++) {
+    std::vector<Term> products;
+    for (const Term& term : terms) {
+      products.push_back(term.adjoint().product(row_basis.element(r)));
+    }
+    for (const auto& [operators, coefficient] :
+         NormalOrderer(products).terms()) {
+      if (coefficient != Term::CoeffType{} &&
+          (operators.empty() ||
+           operators.back().type() == Operator::Type::Creation) &&
+          column_basis.contains(operators)) {
+        result[{r, column_basis.index(operators)}] = std::conj(coefficient);
+      }
+    }
+  }
+  return result;
+}
+
+Elements compiled_elements(
+    const CompiledExpression& compiled, const Basis& row_basis,
+    const Basis& column_basis) {
+  Elements result;
+  CompiledExpression::Workspace workspace;
+  for (std::size_t r = 0; r < row_basis.size(); r++) {
+    compiled.row(row_basis, r, column_basis, workspace);
+    for (const auto& [column, value] : workspace.entries) {
+      result[{r, column}] = value;
+    }
+  }
+  return result;
+}
+
+void expect_near(const Elements& actual, const Elements& expected) {
+  ASSERT_EQ(actual.size(), expected.size());
+  for (const auto& [index, value] : expected) {
+    auto it = actual.find(index);
+    ASSERT_NE(it, actual.end());
+    EXPECT_NEAR(std::abs(it->second - value), 0.0, 1e-12);
+  }
+}
+
+std::vector<Term> to_terms(const Expression& expression) {
+  std::vector<Term> result;
+  for (const auto& [operators, coefficient] : expression.terms()) {
+    result.push_back(Term(coefficient, operators));
+  }
+  return result;
+}
+
+std::vector<Term> fermionic_terms() {
+  const Term::CoeffType i(0.0, 1.0);
+  return {
+      Term(0.5, {}),
+      one_body<Fermion>(-1.0, Up, 0, Up, 1),
+      one_body<Fermion>(0.3 * i, Down, 2, Down, 0),
+      one_body<Fermion>(0.7, Up, 1, Down, 1),
+      one_body<Fermion>(1.5, Down, 2, Down, 2),
+      density_density<Fermion>(2.0, Up, 0, Down, 0),
+      two_body<Fermion>(0.25, Up, 0, Down, 1, Down, 2, Up, 2),
+      Term(
+          1.0 - i,
+          {Operator::creation<Fermion>(Up, 0),
+           Operator::creation<Fermion>(Down, 1),
+           Operator::creation<Fermion>(Up, 2),
+           Operator::annihilation<Fermion>(Up, 1),
+           Operator::annihilation<Fermion>(Down, 0),
+           Operator::annihilation<Fermion>(Down, 2)}),
+  };
+}
+
+}  // namespace
+
+TEST(CompiledExpressionTest, Classification) {
+  CompiledExpression compiled(fermionic_terms());
+  EXPECT_EQ(compiled.diagonal_terms().size(), 3);
+  EXPECT_EQ(compiled.hopping_terms().size(), 3);
+  EXPECT_EQ(compiled.two_body_terms().size(), 1);
+  EXPECT_EQ(compiled.fermionic_terms().size(), 1);
+  EXPECT_TRUE(compiled.generic_terms().empty());
+}
+
+TEST(CompiledExpressionTest, FermionicRowsMatchNormalOrdering) {
+  const std::vector<Term> terms = fermionic_terms();
+  CompiledExpression compiled(terms);
+  for (std::size_t particles = 0; particles <= 6; particles++) {
+    FermionicBasis basis(3, particles);
+    expect_near(
+        compiled_elements(compiled, basis, basis),
+        reference_elements(terms, basis, basis));
+  }
+}
+
+TEST(CompiledExpressionTest, NoDoubleOccupancyBasis) {
+  const std::vector<Term> terms = fermionic_terms();
+  CompiledExpression compiled(terms);
+  FermionicBasis basis(3, 2, /*allow_double_occupancy=*/false);
+  expect_near(
+      compiled_elements(compiled, basis, basis),
+      reference_elements(terms, basis, basis));
+}
+
+TEST(CompiledExpressionTest, SpinOperators) {
+  Expression heisenberg;
+  for (std::size_t i = 0; i < 4; i++) {
+    std::size_t j = (i + 1) % 4;
+    heisenberg.insert(spin_x(i) * spin_x(j));
+    heisenberg.insert(spin_y(i) * spin_y(j));
+    heisenberg.insert(spin_z(i) * spin_z(j));
+  }
+  const std::vector<Term> terms = to_terms(heisenberg);
+  CompiledExpression compiled(heisenberg);
+  FermionicBasis basis(4, 4, /*allow_double_occupancy=*/false);
+  expect_near(
+      compiled_elements(compiled, basis, basis),
+      reference_elements(terms, basis, basis));
+}
+
+TEST(CompiledExpressionTest, BosonicTermsUseFallback) {
+  std::vector<Term> terms;
+  for (std::size_t i = 0; i < 3; i++) {
+    terms.push_back(one_body<Boson>(-1.0, Up, i, Up, (i + 1) % 3));
+    terms.push_back(one_body<Boson>(-1.0, Up, (i + 1) % 3, Up, i));
+    terms.push_back(density_density<Boson>(0.5, Up, i, Up, i));
+  }
+  CompiledExpression compiled(terms);
+  EXPECT_FALSE(compiled.generic_terms().empty());
+  BosonicBasis basis(3, 3);
+  expect_near(
+      compiled_elements(compiled, basis, basis),
+      reference_elements(terms, basis, basis));
+}
+
+TEST(CompiledExpressionTest, RowsBetweenDifferentBases) {
+  std::vector<Term> terms = {
+      Term(1.0, {Operator::creation<Fermion>(Up, 0)}),
+      Term(2.0, {Operator::creation<Fermion>(Down, 1)}),
+  };
+  CompiledExpression compiled(terms);
+  FermionicBasis two(2, 2);
+  FermionicBasis one(2, 1);
+  expect_near(
+      compiled_elements(compiled, two, one),
+      reference_elements(terms, two, one));
+}
+
+TEST(CompiledExpressionTest, ApplyBetweenDifferentBases) {
+  std::vector<Term> terms = {
+      Term(1.0, {Operator::creation<Fermion>(Up, 0)}),
+      Term(2.0, {Operator::creation<Fermion>(Down, 1)}),
+  };
+  CompiledExpression compiled(terms);
+  FermionicBasis source(3, 2);
+  FermionicBasis target(3, 3);
+
+  std::vector<Term::CoeffType> x(source.size());
+  for (std::size_t k = 0; k < x.size(); k++) {
+    x[k] = {1.0 / static_cast<double>(k + 1), 0.1 * static_cast<double>(k)};
+  }
+  std::vector<Term::CoeffType> y(target.size());
+  compiled.apply(source, x, target, y);
+
+  std::vector<Term::CoeffType> expected(target.size());
+  for (const auto& [index, value] :
+       reference_elements(terms, target, source)) {
+    expected[index.first] += value * x[index.second];
+  }
+  for (std::size_t k = 0; k < y.size(); k++) {
+    EXPECT_NEAR(std::abs(y[k] - expected[k]), 0.0, 1e-12);
+  }
+}
+
+TEST(CompiledExpressionTest, ApplyAndExpectation) {
+  const std::vector<Term> terms = fermionic_terms();
+  CompiledExpression compiled(terms);
+  FermionicBasis basis(3, 3);
+
+  std::vector<Term::CoeffType> x(basis.size());
+  for (std::size_t k = 0; k < x.size(); k++) {
+    x[k] = {1.0 / static_cast<double>(k + 1), 0.1 * static_cast<double>(k)};
+  }
+  std::vector<Term::CoeffType> y(basis.size());
+  compiled.apply(basis, x, y);
+
+  std::vector<Term::CoeffType> expected(basis.size());
+  for (const auto& [index, value] : reference_elements(terms, basis, basis)) {
+    expected[index.first] += value * x[index.second];
+  }
+  Term::CoeffType expectation{};
+  for (std::size_t k = 0; k < y.size(); k++) {
+    EXPECT_NEAR(std::abs(y[k] - expected[k]), 0.0, 1e-12);
+    expectation += std::conj(x[k]) * expected[k];
+  }
+  EXPECT_NEAR(
+      std::abs(compiled.expectation(basis, x) - expectation), 0.0, 1e-12);
+}
+
+TEST(CompiledExpressionTest, ModelCachesCompiledHamiltonian) {
+  HubbardChain model(1.0, 4.0, 4);
+  const CompiledExpression& compiled = model.compiled_hamiltonian();
+  EXPECT_EQ(&model.compiled_hamiltonian(), &compiled);
+
+  FermionicBasis basis(4, 4);
+  SparseMatrix<std::complex<double>> m;
+  model.compute_matrix_elements(basis, m);
+  Elements elements = compiled_elements(compiled, basis, basis);
+  ASSERT_EQ(m.size(), elements.size());
+  for (const auto& [index, value] : elements) {
+    EXPECT_EQ(m(index.first, index.second), value);
+  }
+}
+
+TEST(CompiledExpressionTest, DiagonalMatchesRows) {
+  const std::vector<Term> terms = fermionic_terms();
+  CompiledExpression compiled(terms);
+  FermionicBasis basis(3, 3);
+  Elements expected = reference_elements(terms, basis, basis);
+
+  std::vector<Term::CoeffType> diagonal = compiled.diagonal(basis);
+  ASSERT_EQ(diagonal.size(), basis.size());
+  CompiledExpression::Workspace workspace;
+  for (std::size_t r = 0; r < basis.size(); r++) {
+    auto it = expected.find({r, r});
+    Term::CoeffType value = it == expected.end() ? 0.0 : it->second;
+    EXPECT_NEAR(std::abs(diagonal[r] - value), 0.0, 1e-12);
+
+    compiled.off_diagonal_row(basis, r, workspace);
+    for (const auto& [column, element] : workspace.entries) {
+      EXPECT_NE(column, r);
+      EXPECT_EQ(element, expected.at({r, column}));
+    }
+  }
+}
+
+TEST(CompiledExpressionTest, DiagonalOfBosonicTerms) {
+  std::vector<Term> terms;
+  for (std::size_t i = 0; i < 3; i++) {
+    terms.push_back(one_body<Boson>(-1.0, Up, i, Up, (i + 1) % 3));
+    terms.push_back(density_density<Boson>(0.5, Up, i, Up, i));
+  }
+  CompiledExpression compiled(terms);
+  BosonicBasis basis(3, 3);
+  Elements expected = reference_elements(terms, basis, basis);
+  std::vector<Term::CoeffType> diagonal = compiled.diagonal(basis);
+  for (std::size_t r = 0; r < basis.size(); r++) {
+    EXPECT_NEAR(std::abs(diagonal[r] - expected.at({r, r})), 0.0, 1e-12);
+  }
+}
+
+TEST(CompiledExpressionTest, ModelSplitsDiagonal) {
+  HubbardChain model(1.0, 4.0, 4);
+  FermionicBasis basis(4, 4);
+  SparseMatrix<std::complex<double>> full;
+  model.compute_matrix_elements(basis, full);
+
+  std::vector<std::complex<double>> diagonal;
+  SparseMatrix<std::complex<double>> off_diagonal;
+  model.compute_matrix_elements(basis, diagonal, off_diagonal);
+
+  std::size_t nonzero_diagonal = 0;
+  for (std::size_t r = 0; r < basis.size(); r++) {
+    if (diagonal[r] != std::complex<double>{}) {
+      EXPECT_EQ(full(r, r), diagonal[r]);
+      nonzero_diagonal++;
+    }
+  }
+  EXPECT_EQ(off_diagonal.size() + nonzero_diagonal, full.size());
+  for (const auto& [index, value] : off_diagonal.elements()) {
+    EXPECT_NE(index.i, index.j);
+    EXPECT_EQ(full(index.i, index.j), value);
+  }
+}
+
+TEST(CompiledExpressionTest, DetectsHermitianOperators) {
+  EXPECT_FALSE(CompiledExpression(fermionic_terms()).hermitian());
+  std::vector<Term> terms = fermionic_terms();
+  for (const Term& term : fermionic_terms()) {
+    terms.push_back(term.adjoint());
+  }
+  EXPECT_TRUE(CompiledExpression(terms).hermitian());
+  EXPECT_TRUE(HubbardChain(1.0, 4.0, 4).compiled_hamiltonian().hermitian());
+}
+
+TEST(CompiledExpressionTest, HermitianMatrixMatchesFullMatrix) {
+  std::vector<Term> terms = fermionic_terms();
+  for (const Term& term : fermionic_terms()) {
+    terms.push_back(term.adjoint());
+  }
+  Expression heisenberg;
+  for (std::size_t i = 0; i < 4; i++) {
+    heisenberg.insert(spin_x(i) * spin_x((i + 1) % 4));
+    heisenberg.insert(spin_y(i) * spin_y((i + 1) % 4));
+  }
+
+  FermionicBasis basis(3, 3);
+  FermionicBasis spin_basis(4, 4, /*allow_double_occupancy=*/false);
+  const std::vector<std::pair<std::vector<Term>, const Basis*>> cases = {
+      {terms, &basis}, {to_terms(heisenberg), &spin_basis}};
+  for (const auto& [case_terms, case_basis] : cases) {
+    CompiledExpression compiled(case_terms);
+    ASSERT_TRUE(compiled.hermitian());
+    CsrMatrix<Term::CoeffType> full = compiled.matrix(*case_basis);
+    HermitianCsrMatrix<Term::CoeffType> half =
+        compiled.hermitian_matrix(*case_basis);
+    EXPECT_LT(half.nonzeros(), full.nonzeros());
+    for (std::size_t i = 0; i < case_basis->size(); i++) {
+      for (std::size_t j = 0; j < case_basis->size(); j++) {
+        EXPECT_NEAR(std::abs(half(i, j) - full(i, j)), 0.0, 1e-12);
+      }
+    }
+
+    std::vector<Term::CoeffType> x(case_basis->size());
+    for (std::size_t k = 0; k < x.size(); k++) {
+      x[k] = {std::sin(static_cast<double>(k)), 1.0};
+    }
+    std::vector<Term::CoeffType> y(case_basis->size());
+    std::vector<Term::CoeffType> expected(case_basis->size());
+    half.multiply(x, y);
+    full.multiply(x, expected);
+    for (std::size_t k = 0; k < y.size(); k++) {
+      EXPECT_NEAR(std::abs(y[k] - expected[k]), 0.0, 1e-12);
+    }
+
+    // Products sharing a workspace do not see each other's partial sums.
+    HermitianCsrMatrix<Term::CoeffType>::Workspace workspace;
+    for (std::size_t product = 0; product < 3; product++) {
+      half.multiply(x, y, workspace);
+      for (std::size_t k = 0; k < y.size(); k++) {
+        EXPECT_NEAR(std::abs(y[k] - expected[k]), 0.0, 1e-12);
+      }
+    }
+  }
+}
@@ -0,0 +1,99 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "Davidson.h"
+
+#include <gtest/gtest.h>
+
+#include "BlockLanczos.h"
+#include "FermionicBasis.h"
+#include "Models/HubbardChain.h"
+#include "SparseMatrix.h"
+#include "TestHelpers.h"
+
+TEST(DavidsonTest, MatrixFree) {
+  HubbardChain model(1.0, 20.0, 5);
+  FermionicBasis basis(5, 5);
+  LinearOperator op(model, basis);
+
+  DavidsonOptions options;
+  options.roots = 3;
+  expect_eigenpairs(
+      op, davidson(op, options), dense_eigenvalues(model, basis),
+      options.roots);
+}
+
+TEST(DavidsonTest, SparseMatrix) {
+  HubbardChain model(1.0, 8.0, 5);
+  FermionicBasis basis(5, 4);
+  SparseMatrix<Complex> matrix;
+  model.compute_matrix_elements(basis, matrix);
+  LinearOperator op(matrix, basis.size());
+
+  DavidsonOptions options;
+  options.roots = 2;
+  expect_eigenpairs(
+      op, davidson(op, options), dense_eigenvalues(model, basis),
+      options.roots);
+}
+
+TEST(DavidsonTest, Restart) {
+  HubbardChain model(1.0, 20.0, 5);
+  FermionicBasis basis(5, 5);
+  LinearOperator op(model, basis);
+
+  DavidsonOptions options;
+  options.roots = 2;
+  options.max_basis = 8;
+  EigenResult result = davidson(op, options);
+  EXPECT_GT(result.restarts, 0);
+  expect_eigenpairs(
+      op, result, dense_eigenvalues(model, basis), options.roots);
+}
+
+TEST(DavidsonTest, OperatorWithoutDiagonal) {
+  HubbardChain model(1.0, 8.0, 4);
+  FermionicBasis basis(4, 4);
+  const CsrMatrix<Complex> matrix = model.matrix(basis);
+  LinearOperator op(
+      matrix.rows(),
+      [&matrix](const ComplexVector& x, ComplexVector& y, std::size_t k) {
+        matrix.multiply_block(x, y, k);
+      });
+  ASSERT_FALSE(op.has_diagonal());
+
+  DavidsonOptions options;
+  options.roots = 2;
+  EigenResult result = davidson(op, options);
+  EXPECT_GE(result.applications, op.size());
+  expect_eigenpairs(
+      op, result, dense_eigenvalues(model, basis), options.roots);
+}
+
+TEST(DavidsonTest, SmallOperator) {
+  // Six states: the default max_basis and restart_size do not fit.
+  HubbardChain model(1.0, 4.0, 2);
+  FermionicBasis basis(2, 2);
+  LinearOperator op(model, basis);
+  ASSERT_EQ(op.size(), 6);
+
+  DavidsonOptions options;
+  options.roots = 3;
+  options.restart_size = 10;
+  expect_eigenpairs(
+      op, davidson(op, options), dense_eigenvalues(model, basis),
+      options.roots);
+}
+
+TEST(DavidsonTest, FewerProductsThanLanczosAtLargeU) {
+  HubbardChain model(1.0, 40.0, 6);
+  FermionicBasis basis(6, 6);
+  LinearOperator op(model, basis);
+
+  EigenResult lanczos = block_lanczos(op);
+  EigenResult result = davidson(op);
+  ASSERT_TRUE(lanczos.converged);
+  ASSERT_TRUE(result.converged);
+  EXPECT_NEAR(result.values[0], lanczos.values[0], 1e-8);
+  EXPECT_LT(result.applications, lanczos.applications);
+}
@@ -0,0 +1,115 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "DensityMatrix.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "FermionicBasis.h"
+
+namespace {
+
+constexpr auto Fermion = Operator::Statistics::Fermion;
+
+StateVector test_state(const Basis& basis) {
+  StateVector state(basis);
+  for (std::size_t k = 0; k < state.size(); k++) {
+    const auto x = static_cast<double>(k);
+    state[k] = {std::sin(x), std::cos(3.0 * x)};
+  }
+  state.normalize();
+  return state;
+}
+
+Operator creation(std::size_t slot) {
+  return Operator::creation<Fermion>(
+      static_cast<Operator::Spin>(slot % 2), slot / 2);
+}
+
+Operator annihilation(std::size_t slot) {
+  return Operator::annihilation<Fermion>(
+      static_cast<Operator::Spin>(slot % 2), slot / 2);
+}
+
+}  // namespace
+
+TEST(DensityMatrixTest, OneBodyMatchesExpectationValues) {
+  FermionicBasis basis(4, 3);
+  const StateVector state = test_state(basis);
+  const DensityMatrices rdm = density_matrices(state);
+  ASSERT_EQ(rdm.slots, 8u);
+  EXPECT_TRUE(rdm.two_body.empty());
+
+  Complex trace{};
+  for (std::size_t i = 0; i < rdm.slots; i++) {
+    trace += rdm.one(i, i);
+    for (std::size_t j = 0; j < rdm.slots; j++) {
+      const Expression op(
+          std::vector<Term>{Term(1.0, {creation(i), annihilation(j)})});
+      EXPECT_NEAR(std::abs(rdm.one(i, j) - state.expectation(op)), 0.0, 1e-12)
+          << i << " " << j;
+    }
+  }
+  EXPECT_NEAR(std::abs(trace - 3.0), 0.0, 1e-12);
+
+  // The occupations of the natural spin-orbitals lie in [0, 1].
+  const HermitianEigen natural = hermitian_eigen(rdm.one_body, rdm.slots);
+  EXPECT_GT(natural.values.front(), -1e-12);
+  EXPECT_LT(natural.values.back(), 1.0 + 1e-12);
+}
+
+TEST(DensityMatrixTest, TwoBodyMatchesExpectationValues) {
+  FermionicBasis basis(3, 3);
+  const StateVector state = test_state(basis);
+  DensityMatrixOptions options;
+  options.two_body = true;
+  const DensityMatrices rdm = density_matrices(state, options);
+  ASSERT_EQ(rdm.two_body_slots.size(), 6u);
+
+  Complex trace{};
+  for (std::size_t i = 0; i < 6; i++) {
+    for (std::size_t j = 0; j < 6; j++) {
+      trace += rdm.two(i, j, i, j);
+      for (std::size_t k = 0; k < 6; k++) {
+        for (std::size_t l = 0; l < 6; l++) {
+          const Expression op(std::vector<Term>{
+              Term(1.0, {creation(i), creation(j), annihilation(l),
+                         annihilation(k)})});
+          EXPECT_NEAR(
+              std::abs(rdm.two(i, j, k, l) - state.expectation(op)), 0.0,
+              1e-12);
+        }
+      }
+    }
+  }
+  // sum_ij <c^dagger_i c^dagger_j c_j c_i> = N (N - 1).
+  EXPECT_NEAR(std::abs(trace - 6.0), 0.0, 1e-12);
+}
+
+TEST(DensityMatrixTest, TwoBodyRestrictedToOrbitals) {
+  FermionicBasis basis(4, 4);
+  const StateVector state = test_state(basis);
+  DensityMatrixOptions options;
+  options.two_body = true;
+  const DensityMatrices full = density_matrices(state, options);
+  options.orbitals = {3, 1};
+  const DensityMatrices part = density_matrices(state, options);
+  ASSERT_EQ(part.two_body_slots, (std::vector<std::size_t>{2, 3, 6, 7}));
+  EXPECT_EQ(part.two_body.size(), 36u);
+  for (std::size_t i : part.two_body_slots) {
+    for (std::size_t j : part.two_body_slots) {
+      for (std::size_t k : part.two_body_slots) {
+        for (std::size_t l : part.two_body_slots) {
+          EXPECT_NEAR(
+              std::abs(part.two(i, j, k, l) - full.two(i, j, k, l)), 0.0,
+              1e-12);
+        }
+      }
+    }
+  }
+  for (std::size_t k = 0; k < full.one_body.size(); k++) {
+    EXPECT_NEAR(std::abs(part.one_body[k] - full.one_body[k]), 0.0, 1e-12);
+  }
+}
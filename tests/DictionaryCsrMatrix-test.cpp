@@ -0,0 +1,58 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "DictionaryCsrMatrix.h"
+
+#include <gtest/gtest.h>
+
+#include "FermionicBasis.h"
+#include "Models/HubbardSquare.h"
+
+TEST(DictionaryCsrMatrixTest, CompressHubbardSquare) {
+  HubbardSquare model(1.0, 4.0, 2, 3);
+  FermionicBasis basis(model.size(), 6);
+  CsrMatrix<std::complex<double>> matrix = model.matrix(basis);
+
+  auto compressed =
+      DictionaryCsrMatrix<std::complex<double>, std::uint8_t>::compress(matrix);
+  ASSERT_TRUE(compressed.has_value());
+  EXPECT_EQ(compressed->nonzeros(), matrix.nonzeros());
+  EXPECT_LE(compressed->table().size(), 16);
+  for (std::size_t k = 0; k < matrix.nonzeros(); k++) {
+    EXPECT_EQ(compressed->columns()[k], matrix.columns()[k]);
+    EXPECT_EQ(
+        compressed->table()[compressed->value_indices()[k]],
+        matrix.values()[k]);
+  }
+
+  std::vector<std::complex<double>> x(basis.size());
+  for (std::size_t k = 0; k < x.size(); k++) {
+    x[k] = {1.0 / static_cast<double>(k + 1), std::cos(static_cast<double>(k))};
+  }
+  std::vector<std::complex<double>> y(basis.size());
+  std::vector<std::complex<double>> expected(basis.size());
+  compressed->multiply(x, y);
+  matrix.multiply(x, expected);
+  for (std::size_t k = 0; k < y.size(); k++) {
+    EXPECT_NEAR(std::abs(y[k] - expected[k]), 0.0, 1e-12);
+  }
+}
+
+TEST(DictionaryCsrMatrixTest, TooManyDistinctValues) {
+  const std::size_t size = 300;
+  std::vector<std::size_t> offsets(size + 1);
+  std::vector<std::size_t> columns(size);
+  std::vector<double> values(size);
+  for (std::size_t k = 0; k < size; k++) {
+    offsets[k + 1] = k + 1;
+    columns[k] = k;
+    values[k] = static_cast<double>(k);
+  }
+  CsrMatrix<double> diagonal(size, offsets, columns, values);
+
+  EXPECT_FALSE((DictionaryCsrMatrix<double, std::uint8_t>::compress(diagonal)
+                    .has_value()));
+  auto compressed = DictionaryCsrMatrix<double>::compress(diagonal);
+  ASSERT_TRUE(compressed.has_value());
+  EXPECT_EQ(compressed->table().size(), size);
+}
@@ -0,0 +1,94 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "Entanglement.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "BlockLanczos.h"
+#include "DensityMatrix.h"
+#include "FermionicBasis.h"
+#include "Models/HubbardChain.h"
+#include "Models/LinearChain.h"
+
+namespace {
+
+StateVector ground_state(const Model& model, const Basis& basis) {
+  const EigenResult result = block_lanczos(LinearOperator(model, basis));
+  return StateVector(basis, result.vectors[0]);
+}
+
+}  // namespace
+
+TEST(EntanglementTest, ProductState) {
+  FermionicBasis basis(4, 2);
+  const EntanglementSpectrum spectrum =
+      entanglement_spectrum(StateVector::basis_state(basis, 3), {0, 2});
+  EXPECT_NEAR(spectrum.entropy(), 0.0, 1e-12);
+  EXPECT_NEAR(spectrum.values().front(), 1.0, 1e-12);
+}
+
+TEST(EntanglementTest, SlaterDeterminantMatchesCorrelationMatrix) {
+  // The reduced density matrix of a Slater determinant is fixed by the
+  // eigenvalues nu of the correlation matrix restricted to A, with
+  // S = -sum nu ln nu + (1 - nu) ln (1 - nu). Its signs depend on A not
+  // being contiguous.
+  LinearChain model(6, 1.0, 0.0);
+  FermionicBasis basis(6, 6);
+  const StateVector state = ground_state(model, basis);
+  const std::vector<std::size_t> region = {0, 2, 3};
+
+  const DensityMatrices rdm = density_matrices(state);
+  std::vector<std::size_t> slots;
+  for (std::size_t orbital : region) {
+    slots.push_back(2 * orbital);
+    slots.push_back(2 * orbital + 1);
+  }
+  ComplexVector correlation(slots.size() * slots.size());
+  for (std::size_t j = 0; j < slots.size(); j++) {
+    for (std::size_t i = 0; i < slots.size(); i++) {
+      correlation[i + j * slots.size()] = rdm.one(slots[i], slots[j]);
+    }
+  }
+  double expected = 0.0;
+  for (double nu : hermitian_eigen(correlation, slots.size()).values) {
+    if (nu > 1e-12 && nu < 1.0 - 1e-12) {
+      expected -= nu * std::log(nu) + (1.0 - nu) * std::log(1.0 - nu);
+    }
+  }
+
+  const EntanglementSpectrum spectrum = entanglement_spectrum(state, region);
+  EXPECT_GT(expected, 0.1);
+  EXPECT_NEAR(spectrum.entropy(), expected, 1e-8);
+}
+
+TEST(EntanglementTest, BlocksAndComplement) {
+  HubbardChain model(1.0, 4.0, 4);
+  FermionicBasis basis(4, 4);
+  const StateVector state = ground_state(model, basis);
+
+  const EntanglementSpectrum a = entanglement_spectrum(state, {0, 3});
+  const EntanglementSpectrum b = entanglement_spectrum(state, {1, 2});
+  // The spectrum is that of rho_B as well.
+  EXPECT_NEAR(a.entropy(), b.entropy(), 1e-10);
+  EXPECT_NEAR(a.renyi_entropy(2.0), b.renyi_entropy(2.0), 1e-10);
+
+  // The ground state is a singlet, up to round-off in the other S^z
+  // sectors, so the blocks are resolved by the S^z of A.
+  bool spin_resolved = false;
+  double trace = 0.0;
+  for (const SchmidtBlock& block : a.blocks) {
+    spin_resolved |= block.spin != 0;
+    EXPECT_EQ(block.values.size(), block.region_a.size());
+    EXPECT_EQ(
+        block.matrix.size(), block.region_a.size() * block.region_b.size());
+    for (double p : block.values) {
+      trace += p;
+    }
+  }
+  EXPECT_TRUE(spin_resolved);
+  EXPECT_NEAR(trace, 1.0, 1e-12);
+  EXPECT_LE(a.renyi_entropy(2.0), a.entropy() + 1e-12);
+}
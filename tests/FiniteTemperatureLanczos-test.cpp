@@ -0,0 +1,67 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "FiniteTemperatureLanczos.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+#include <memory>
+
+#include "FermionicBasis.h"
+#include "Models/HubbardChain.h"
+#include "TestHelpers.h"
+
+TEST(FiniteTemperatureLanczosTest, MatchesFullDiagonalisation) {
+  // All particle-number sectors of a 4-site chain, the largest of dimension
+  // 70. The susceptibility is the charge compressibility.
+  const std::size_t sites = 4;
+  HubbardChain model(1.0, 4.0, sites);
+  std::vector<std::unique_ptr<FermionicBasis>> bases;
+  std::vector<ThermodynamicSector> sectors;
+  std::vector<std::vector<double>> spectra;
+  for (std::size_t particles = 0; particles <= 2 * sites; particles++) {
+    bases.push_back(std::make_unique<FermionicBasis>(sites, particles));
+    spectra.push_back(dense_eigenvalues(model, *bases.back()));
+    sectors.push_back(
+        {LinearOperator(model, *bases.back()), static_cast<double>(particles)});
+  }
+
+  FiniteTemperatureLanczosOptions options;
+  options.random_vectors = 100;
+  options.lanczos_steps = 30;
+  const std::vector<double> temperatures = {1.0, 2.0, 5.0};
+  const std::vector<Thermodynamics> result =
+      finite_temperature_lanczos(sectors, temperatures, options);
+
+  ASSERT_EQ(result.size(), temperatures.size());
+  for (std::size_t t = 0; t < temperatures.size(); t++) {
+    const double temperature = temperatures[t];
+    double z = 0.0;
+    double e = 0.0;
+    double e2 = 0.0;
+    double q = 0.0;
+    double q2 = 0.0;
+    for (std::size_t s = 0; s < spectra.size(); s++) {
+      for (double energy : spectra[s]) {
+        const double boltzmann = std::exp(-energy / temperature);
+        z += boltzmann;
+        e += boltzmann * energy;
+        e2 += boltzmann * energy * energy;
+        q += boltzmann * static_cast<double>(s);
+        q2 += boltzmann * static_cast<double>(s * s);
+      }
+    }
+    e /= z;
+    e2 /= z;
+    q /= z;
+    q2 /= z;
+    const double specific_heat = (e2 - e * e) / (temperature * temperature);
+    const double susceptibility = (q2 - q * q) / temperature;
+    EXPECT_EQ(result[t].temperature, temperature);
+    EXPECT_NEAR(result[t].energy, e, 0.01 * std::abs(e));
+    EXPECT_NEAR(result[t].specific_heat, specific_heat, 0.1 * specific_heat);
+    EXPECT_NEAR(
+        result[t].susceptibility, susceptibility, 0.1 * susceptibility);
+  }
+}
@@ -0,0 +1,57 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "FreeFermions.h"
+
+#include <gtest/gtest.h>
+
+#include "BlockLanczos.h"
+#include "DensityMatrix.h"
+#include "FermionicBasis.h"
+#include "Models/HubbardChain.h"
+#include "Models/LinearChain.h"
+#include "TestHelpers.h"
+
+TEST(FreeFermionsTest, DetectsQuadraticHamiltonians) {
+  EXPECT_TRUE(LinearChain(4, 1.0, 0.5).compiled_hamiltonian().quadratic());
+  EXPECT_TRUE(HubbardChain(1.0, 0.0, 4).compiled_hamiltonian().quadratic());
+  EXPECT_FALSE(HubbardChain(1.0, 4.0, 4).compiled_hamiltonian().quadratic());
+}
+
+TEST(FreeFermionsTest, SpectrumMatchesManyBodyMatrix) {
+  LinearChain model(3, 1.0, 0.3);
+  FermionicBasis basis(3, 3);
+  FreeFermions free(model, 3);
+
+  const std::vector<double> expected = dense_eigenvalues(model, basis);
+  const std::vector<double> energies =
+      free.lowest_energies(3, basis.size() + 5);
+  ASSERT_EQ(energies.size(), expected.size());
+  for (std::size_t k = 0; k < expected.size(); k++) {
+    EXPECT_NEAR(energies[k], expected[k], 1e-10);
+  }
+}
+
+TEST(FreeFermionsTest, GroundState) {
+  // A closed shell at half filling, so the ground state is unique.
+  LinearChain model(6, 1.0, 0.3);
+  FermionicBasis basis(6, 6);
+  FreeFermions free(model, 6);
+  EXPECT_EQ(free.slots(), 12u);
+
+  const EigenResult lanczos =
+      block_lanczos(LinearOperator(model, basis));
+  EXPECT_NEAR(free.ground_state_energy(6), lanczos.values[0], 1e-8);
+
+  const StateVector state = free.ground_state(basis);
+  EXPECT_NEAR(state.norm(), 1.0, 1e-12);
+  StateVector residual = state.apply(model.compiled_hamiltonian(), basis);
+  residual.axpy(-free.ground_state_energy(6), state);
+  EXPECT_NEAR(residual.norm(), 0.0, 1e-10);
+
+  const ComplexVector correlation = free.ground_state_correlation(6);
+  const DensityMatrices rdm = density_matrices(state);
+  for (std::size_t k = 0; k < correlation.size(); k++) {
+    EXPECT_NEAR(std::abs(correlation[k] - rdm.one_body[k]), 0.0, 1e-10);
+  }
+}
@@ -0,0 +1,83 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "GaussianState.h"
+
+#include <gtest/gtest.h>
+
+#include "FermionicBasis.h"
+#include "FreeFermions.h"
+#include "Models/LinearChain.h"
+
+namespace {
+
+constexpr auto Fermion = Operator::Statistics::Fermion;
+constexpr auto Up = Operator::Spin::Up;
+constexpr auto Down = Operator::Spin::Down;
+
+}  // namespace
+
+TEST(GaussianStateTest, MatchesSlaterDeterminant) {
+  // An excited Slater determinant of a chain, expanded in the many-body basis
+  // for comparison.
+  const std::size_t sites = 4;
+  LinearChain model(sites, 1.0, 0.3);
+  FermionicBasis basis(sites, 4);
+  FreeFermions free(model, sites);
+  const std::vector<std::size_t> occupied = {0, 2, 3, 5};
+  const StateVector state = free.slater_determinant(basis, occupied);
+  const GaussianState gaussian(free.correlation(occupied), free.slots());
+
+  std::vector<Expression> observables;
+  std::vector<Term> hubbard;
+  for (std::size_t i = 0; i < sites; i++) {
+    const std::size_t j = (i + 1) % sites;
+    for (auto s : {Up, Down}) {
+      hubbard.push_back(one_body<Fermion>(-1.0, s, i, s, j));
+      hubbard.push_back(one_body<Fermion>(-1.0, s, j, s, i));
+    }
+    hubbard.push_back(density_density<Fermion>(4.0, Up, i, Down, i));
+  }
+  observables.emplace_back(hubbard);
+  // S^+_0 S^-_2, which is not normal ordered.
+  observables.emplace_back(std::vector<Term>{
+      two_body<Fermion>({0.5, 0.1}, Up, 0, Down, 0, Down, 2, Up, 2)});
+  // A three-body string and a product of a creation and an annihilation
+  // operator in reverse order.
+  observables.emplace_back(std::vector<Term>{Term(
+      1.0, {Operator::creation<Fermion>(Up, 0),
+            Operator::creation<Fermion>(Down, 1),
+            Operator::creation<Fermion>(Up, 2),
+            Operator::annihilation<Fermion>(Up, 3),
+            Operator::annihilation<Fermion>(Up, 1),
+            Operator::annihilation<Fermion>(Down, 0)})});
+  observables.emplace_back(std::vector<Term>{
+      Term(2.0, {Operator::annihilation<Fermion>(Down, 3),
+                 Operator::creation<Fermion>(Down, 3)})});
+
+  for (const Expression& observable : observables) {
+    EXPECT_NEAR(
+        std::abs(gaussian.expectation(observable) -
+                 state.expectation(observable)),
+        0.0, 1e-12);
+  }
+  EXPECT_GT(std::abs(gaussian.expectation(observables[0])), 0.1);
+}
+
+TEST(GaussianStateTest, ParticleNumberMustBeConserved) {
+  ComplexVector correlation(4);
+  correlation[0] = 0.5;
+  correlation[3] = 0.25;
+  const GaussianState gaussian(correlation, 2);
+  EXPECT_EQ(
+      gaussian.expectation(std::vector<Term>{
+          Term(1.0, {Operator::creation<Fermion>(Up, 0)})}),
+      Complex{});
+  // <n_0 n_1> = G_00 G_11 - G_01 G_10.
+  EXPECT_NEAR(
+      std::abs(
+          gaussian.expectation(std::vector<Term>{
+              density_density<Fermion>(1.0, Up, 0, Down, 0)}) -
+          0.125),
+      0.0, 1e-15);
+}
@@ -0,0 +1,63 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "GreenFunction.h"
+
+#include <gtest/gtest.h>
+
+#include "CompiledExpression.h"
+#include "FermionicBasis.h"
+#include "Models/HubbardChain.h"
+#include "TestHelpers.h"
+
+namespace {
+
+constexpr auto Fermion = Operator::Statistics::Fermion;
+
+}  // namespace
+
+TEST(GreenFunctionTest, ContinuedFractionOfTwoLevels) {
+  // a_0 = 1, b_0 = 2, a_1 = -1: the matrix [[1, 2], [2, -1]], with
+  // eigenvalues +-sqrt(5), seen from its first basis vector.
+  ContinuedFraction fraction{3.0, {1.0, -1.0}, {2.0}};
+  const double root = std::sqrt(5.0);
+  const double w = (1.0 + 1.0 / root) / 2.0;
+  const Complex z{0.3, 0.1};
+  const Complex expected = 3.0 * (w / (z - root) + (1.0 - w) / (z + root));
+  EXPECT_NEAR(std::abs(fraction(z) - expected), 0.0, 1e-12);
+}
+
+TEST(GreenFunctionTest, ElectronAdditionMatchesLehmannSum) {
+  HubbardChain model(1.0, 4.0, 4);
+  FermionicBasis basis(4, 4);
+  FermionicBasis target(4, 5);
+  const HermitianEigen ground = dense_eigen(model.matrix(basis));
+  const ComplexVector psi(
+      ground.vectors.begin(),
+      ground.vectors.begin() + static_cast<std::ptrdiff_t>(basis.size()));
+
+  const Expression op(std::vector<Term>{
+      Term(1.0, {Operator::creation<Fermion>(Operator::Spin::Up, 0)})});
+  LinearOperator hamiltonian(model, target);
+  ContinuedFraction fraction =
+      dynamical_correlation(hamiltonian, op, basis, psi, target);
+
+  // Lehmann representation from the eigenstates of the target sector.
+  ComplexVector phi(target.size());
+  CompiledExpression(op).apply(basis, psi, target, phi);
+  const HermitianEigen excited = dense_eigen(model.matrix(target));
+  const std::size_t n = target.size();
+  EXPECT_NEAR(fraction.weight, dot(phi, phi).real(), 1e-12);
+  for (double omega = -2.0; omega <= 6.0; omega += 0.5) {
+    const Complex z{omega + ground.values[0], 0.05};
+    Complex expected{};
+    for (std::size_t l = 0; l < n; l++) {
+      Complex overlap{};
+      for (std::size_t i = 0; i < n; i++) {
+        overlap += std::conj(excited.vectors[i + l * n]) * phi[i];
+      }
+      expected += std::norm(overlap) / (z - excited.values[l]);
+    }
+    EXPECT_NEAR(std::abs(fraction(z) - expected), 0.0, 1e-8);
+  }
+}
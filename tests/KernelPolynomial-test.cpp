@@ -0,0 +1,103 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "KernelPolynomial.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "FermionicBasis.h"
+#include "Models/HubbardChain.h"
+#include "TestHelpers.h"
+
+namespace {
+
+// sum_l w_l T_m(x_l) for the rescaled eigenvalues x_l.
+double exact_moment(
+    const std::vector<double>& values, const std::vector<double>& weights,
+    SpectralBounds bounds, std::size_t m) {
+  const double center = (bounds.upper + bounds.lower) / 2.0;
+  const double half_width = (bounds.upper - bounds.lower) / 2.0;
+  double result = 0.0;
+  for (std::size_t l = 0; l < values.size(); l++) {
+    const double x = (values[l] - center) / half_width;
+    result += weights[l] * std::cos(static_cast<double>(m) * std::acos(x));
+  }
+  return result;
+}
+
+}  // namespace
+
+TEST(KernelPolynomialTest, SpectralBounds) {
+  HubbardChain model(1.0, 4.0, 4);
+  FermionicBasis basis(4, 4);
+  const CsrMatrix<Complex> matrix = model.matrix(basis);
+  const HermitianEigen eigen = dense_eigen(matrix);
+  SpectralBounds bounds = spectral_bounds(LinearOperator(matrix));
+  EXPECT_LT(bounds.lower, eigen.values.front());
+  EXPECT_GT(bounds.upper, eigen.values.back());
+}
+
+TEST(KernelPolynomialTest, SpectralFunctionMoments) {
+  HubbardChain model(1.0, 4.0, 4);
+  FermionicBasis basis(4, 4);
+  const CsrMatrix<Complex> matrix = model.matrix(basis);
+  const HermitianEigen eigen = dense_eigen(matrix);
+  const std::size_t n = basis.size();
+  LinearOperator op(matrix);
+  SpectralBounds bounds = spectral_bounds(op);
+
+  std::mt19937_64 rng(4);
+  const ComplexVector phi = random_vector(n, rng);
+  std::vector<double> weights(n);
+  for (std::size_t l = 0; l < n; l++) {
+    Complex overlap{};
+    for (std::size_t i = 0; i < n; i++) {
+      overlap += std::conj(eigen.vectors[i + l * n]) * phi[i];
+    }
+    weights[l] = std::norm(overlap);
+  }
+
+  KernelPolynomialOptions options;
+  options.moments = 65;
+  ChebyshevExpansion expansion =
+      kpm_spectral_function(op, phi, bounds, options);
+  for (std::size_t m = 0; m < options.moments; m++) {
+    EXPECT_NEAR(
+        expansion.moments()[m],
+        exact_moment(eigen.values, weights, bounds, m), 1e-9);
+  }
+
+  // The density integrates to <phi|phi>.
+  const std::size_t points = 4000;
+  const double step = (bounds.upper - bounds.lower) / points;
+  double integral = 0.0;
+  for (std::size_t i = 0; i < points; i++) {
+    integral += expansion(bounds.lower + (static_cast<double>(i) + 0.5) * step);
+  }
+  EXPECT_NEAR(integral * step, dot(phi, phi).real(), 1e-2 * norm(phi));
+}
+
+TEST(KernelPolynomialTest, StochasticDensityOfStates) {
+  HubbardChain model(1.0, 4.0, 5);
+  FermionicBasis basis(5, 5);
+  const CsrMatrix<Complex> matrix = model.matrix(basis);
+  const HermitianEigen eigen = dense_eigen(matrix);
+  LinearOperator op(matrix);
+  SpectralBounds bounds = spectral_bounds(op);
+
+  KernelPolynomialOptions options;
+  options.moments = 32;
+  options.random_vectors = 64;
+  options.block_size = 8;
+  ChebyshevExpansion dos = kpm_density_of_states(op, bounds, options);
+  const std::vector<double> weights(
+      eigen.values.size(), 1.0 / static_cast<double>(eigen.values.size()));
+  EXPECT_NEAR(dos.moments()[0], 1.0, 1e-12);
+  for (std::size_t m = 1; m < options.moments; m++) {
+    EXPECT_NEAR(
+        dos.moments()[m], exact_moment(eigen.values, weights, bounds, m),
+        0.03);
+  }
+}
@@ -0,0 +1,142 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "LinearAlgebra.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+namespace {
+
+// Deterministic n x n Hermitian matrix, column-major.
+ComplexVector test_matrix(std::size_t n) {
+  ComplexVector a(n * n);
+  for (std::size_t j = 0; j < n; j++) {
+    for (std::size_t i = 0; i < n; i++) {
+      const double x = static_cast<double>(3 * i + 7 * j);
+      const double y = static_cast<double>(3 * j + 7 * i);
+      a[i + j * n] = {std::sin(x) + std::sin(y), std::cos(x) - std::cos(y)};
+    }
+  }
+  return a;
+}
+
+}  // namespace
+
+TEST(LinearAlgebraTest, TridiagonalEigen) {
+  // The discrete Laplacian, with eigenvalues 2 - 2 cos(k pi / (n + 1)).
+  const std::size_t n = 10;
+  TridiagonalEigen eigen = tridiagonal_eigen(
+      std::vector<double>(n, 2.0), std::vector<double>(n - 1, -1.0));
+  for (std::size_t k = 0; k < n; k++) {
+    const double expected =
+        2.0 - 2.0 * std::cos(static_cast<double>(k + 1) * M_PI /
+                             static_cast<double>(n + 1));
+    EXPECT_NEAR(eigen.values[k], expected, 1e-12);
+    for (std::size_t i = 0; i < n; i++) {
+      double value = 2.0 * eigen.vectors[i + k * n];
+      if (i > 0) {
+        value -= eigen.vectors[i - 1 + k * n];
+      }
+      if (i + 1 < n) {
+        value -= eigen.vectors[i + 1 + k * n];
+      }
+      EXPECT_NEAR(value, eigen.values[k] * eigen.vectors[i + k * n], 1e-12);
+    }
+  }
+}
+
+TEST(LinearAlgebraTest, TridiagonalEigenIterationCap) {
+  const std::size_t n = 10;
+  const std::vector<double> diagonal(n, 2.0);
+  const std::vector<double> off_diagonal(n - 1, -1.0);
+  EXPECT_TRUE(tridiagonal_eigen(diagonal, off_diagonal).converged);
+  // Every eigenvalue of the coupled matrix needs at least one sweep.
+  EXPECT_FALSE(tridiagonal_eigen(diagonal, off_diagonal, true, 0).converged);
+  EXPECT_FALSE(tridiagonal_eigen(diagonal, off_diagonal, false, 1).converged);
+  // A diagonal matrix needs none.
+  EXPECT_TRUE(
+      tridiagonal_eigen(diagonal, std::vector<double>(n - 1, 0.0), true, 0)
+          .converged);
+}
+
+TEST(LinearAlgebraTest, HermitianEigen) {
+  const std::size_t n = 20;
+  const ComplexVector a = test_matrix(n);
+  HermitianEigen eigen = hermitian_eigen(a, n);
+  for (std::size_t k = 0; k + 1 < n; k++) {
+    EXPECT_LE(eigen.values[k], eigen.values[k + 1]);
+  }
+  for (std::size_t k = 0; k < n; k++) {
+    for (std::size_t i = 0; i < n; i++) {
+      Complex value{};
+      for (std::size_t j = 0; j < n; j++) {
+        value += a[i + j * n] * eigen.vectors[j + k * n];
+      }
+      EXPECT_NEAR(
+          std::abs(value - eigen.values[k] * eigen.vectors[i + k * n]), 0.0,
+          1e-12);
+    }
+    for (std::size_t l = 0; l < n; l++) {
+      Complex overlap{};
+      for (std::size_t i = 0; i < n; i++) {
+        overlap += std::conj(eigen.vectors[i + k * n]) *
+                   eigen.vectors[i + l * n];
+      }
+      EXPECT_NEAR(std::abs(overlap - (k == l ? 1.0 : 0.0)), 0.0, 1e-12);
+    }
+  }
+}
+
+TEST(LinearAlgebraTest, Orthonormalize) {
+  const std::size_t n = 50;
+  const std::size_t k = 3;
+  std::mt19937_64 rng(1);
+  ComplexVector w = random_vector(n * k, rng);
+  // The last column is a combination of the first two.
+  for (std::size_t i = 0; i < n; i++) {
+    w[i * k + 2] = 2.0 * w[i * k] - Complex{0.0, 1.0} * w[i * k + 1];
+  }
+  const ComplexVector original = w;
+  const ComplexVector r = orthonormalize(w, k, {}, k, rng);
+
+  const ComplexVector gram = block_inner(w, k, w, k);
+  for (std::size_t b = 0; b < k; b++) {
+    for (std::size_t a = 0; a < k; a++) {
+      EXPECT_NEAR(std::abs(gram[a + b * k] - (a == b ? 1.0 : 0.0)), 0.0, 1e-12);
+    }
+  }
+  EXPECT_NEAR(std::abs(r[2 + 2 * k]), 0.0, 1e-12);
+  const ComplexVector product = block_multiply(w, k, r, k);
+  for (std::size_t i = 0; i < n * k; i++) {
+    EXPECT_NEAR(std::abs(product[i] - original[i]), 0.0, 1e-12);
+  }
+}
+
+TEST(LinearAlgebraTest, Determinant) {
+  // The product of the eigenvalues, for a matrix shifted away from the
+  // singular test_matrix().
+  const std::size_t n = 7;
+  ComplexVector a = test_matrix(n);
+  for (std::size_t i = 0; i < n; i++) {
+    a[i + i * n] += static_cast<double>(i + 1);
+  }
+  const HermitianEigen eigen = hermitian_eigen(a, n);
+  double product = 1.0;
+  for (double value : eigen.values) {
+    product *= value;
+  }
+  EXPECT_GT(std::abs(product), 1.0);
+  EXPECT_NEAR(std::abs(determinant(a, n) - product), 0.0,
+              1e-10 * std::abs(product));
+
+  // An odd permutation, which needs pivoting.
+  ComplexVector permutation(9);
+  permutation[1 + 0 * 3] = 1.0;
+  permutation[0 + 1 * 3] = 2.0;
+  permutation[2 + 2 * 3] = Complex(0.0, 1.0);
+  EXPECT_NEAR(
+      std::abs(determinant(permutation, 3) - Complex(0.0, -2.0)), 0.0, 1e-15);
+  EXPECT_EQ(determinant(ComplexVector(4), 2), Complex{});
+}
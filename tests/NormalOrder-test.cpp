@@ -6,6 +6,8 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <random>
+
 using testing::IsEmpty;
 
 using enum Operator::Type;
@@ -628,3 +630,168 @@ TEST(DISABLED_NormalOrderTest, NormalOrderOutofOrderCaseWithoutIndex) {
   Term term(1.0, operators);
   Expression e = NormalOrderer(term).expression();
 }
+
+namespace {
+
+// The identity coefficient of the normal ordered term, which is what
+// vacuum_expectation() computes directly.
+Term::CoeffType normal_ordered_vacuum(const Term& term) {
+  const Expression::ExpressionMap terms = NormalOrderer(term).terms();
+  auto it = terms.find({});
+  return it == terms.end() ? Term::CoeffType{} : it->second;
+}
+
+std::vector<Operator> random_string(
+    std::mt19937& rng, Operator::Statistics statistics, std::size_t size) {
+  std::vector<Operator> operators;
+  for (std::size_t k = 0; k < size; k++) {
+    const auto bits = rng();
+    operators.push_back(Operator(
+        (bits & 1) != 0 ? Creation : Annihilation, statistics,
+        (bits & 2) != 0 ? Up : Down, (bits >> 2) % 2));
+  }
+  return operators;
+}
+
+}  // namespace
+
+TEST(NormalOrderTest, VacuumExpectationMatchesNormalOrdering) {
+  std::mt19937 rng(7);
+  for (auto statistics : {Fermion, Boson}) {
+    for (std::size_t trial = 0; trial < 200; trial++) {
+      const Term term(
+          {1.5, -0.5}, random_string(rng, statistics, 2 + 2 * (trial % 4)));
+      EXPECT_EQ(vacuum_expectation(term), normal_ordered_vacuum(term));
+    }
+  }
+  // b b b^dagger b^dagger |0> = 2 |0>, and c c^dagger c c^dagger |0> = |0>.
+  EXPECT_EQ(
+      vacuum_expectation(
+          Term(1.0, {Operator::annihilation<Boson>(Up, 0),
+                     Operator::annihilation<Boson>(Up, 0),
+                     Operator::creation<Boson>(Up, 0),
+                     Operator::creation<Boson>(Up, 0)})),
+      Term::CoeffType(2.0));
+  EXPECT_EQ(
+      vacuum_expectation(
+          Term(1.0, {Operator::annihilation<Fermion>(Up, 0),
+                     Operator::creation<Fermion>(Up, 0),
+                     Operator::annihilation<Fermion>(Up, 0),
+                     Operator::creation<Fermion>(Up, 0)})),
+      Term::CoeffType(1.0));
+}
+
+TEST(NormalOrderTest, VacuumExpectationOfLongString) {
+  // The string of NormalOrderOutofOrderCaseWithoutIndex, whose normal
+  // ordering is too slow to run.
+  std::vector<Operator> operators;
+  for (int i = 0; i < 16; i++) {
+    operators.push_back(Operator::annihilation<Fermion>(Up, 0));
+  }
+  for (int i = 0; i < 16; i++) {
+    operators.push_back(Operator::creation<Fermion>(Up, 0));
+  }
+  EXPECT_EQ(vacuum_expectation(operators), Term::CoeffType{});
+
+  // (b b^dagger)^16 |0> = |0>.
+  operators.clear();
+  for (int i = 0; i < 16; i++) {
+    operators.push_back(Operator::annihilation<Boson>(Up, 3));
+    operators.push_back(Operator::creation<Boson>(Up, 3));
+  }
+  EXPECT_EQ(vacuum_expectation(operators), Term::CoeffType(1.0));
+}
+
+TEST(NormalOrderTest, ReferenceExpectationMatchesNormalOrdering) {
+  std::mt19937 rng(11);
+  for (auto statistics : {Fermion, Boson}) {
+    for (std::size_t trial = 0; trial < 100; trial++) {
+      std::vector<Operator> reference;
+      for (const Operator& op : random_string(rng, statistics, 3)) {
+        reference.push_back(Operator(
+            Creation, statistics, op.spin(), op.orbital()));
+      }
+      const Expression expression(std::vector<Term>{
+          Term(1.0, random_string(rng, statistics, 2)),
+          Term({0.0, 2.0}, random_string(rng, statistics, 4))});
+
+      Term::CoeffType expected{};
+      for (const auto& [operators, coefficient] : expression.terms()) {
+        expected += normal_ordered_vacuum(Term(1.0, reference)
+                                              .adjoint()
+                                              .product(operators)
+                                              .product(reference)) *
+                    coefficient;
+      }
+      EXPECT_EQ(reference_expectation(expression, reference), expected);
+    }
+  }
+}
+
+TEST(NormalOrderTest, TruncationMatchesFiltering) {
+  std::mt19937 rng(13);
+  for (auto statistics : {Fermion, Boson}) {
+    for (std::size_t trial = 0; trial < 100; trial++) {
+      const Term term(
+          {1.5, -0.5}, random_string(rng, statistics, 4 + 2 * (trial % 3)));
+      const Expression::ExpressionMap full = NormalOrderer(term).terms();
+      for (std::size_t max_length : {1u, 2u, 4u}) {
+        NormalOrderOptions options;
+        options.max_length = max_length;
+        Expression::ExpressionMap expected;
+        for (const auto& [operators, coefficient] : full) {
+          if (operators.size() <= max_length) {
+            expected.emplace(operators, coefficient);
+          }
+        }
+        EXPECT_EQ(NormalOrderer(term, options).terms(), expected);
+      }
+    }
+  }
+}
+
+TEST(NormalOrderTest, TruncationOfLongString) {
+  // A shorter string of NormalOrderOutofOrderCaseWithIndex: c_9 ... c_2
+  // c^dagger_0 ... c^dagger_7, in which at most six pairs contract.
+  std::vector<Operator> operators;
+  for (std::size_t i = 0; i < 8; i++) {
+    operators.push_back(Operator::annihilation<Fermion>(Up, 9 - i));
+  }
+  for (std::size_t i = 0; i < 8; i++) {
+    operators.push_back(Operator::creation<Fermion>(Up, i));
+  }
+  NormalOrderOptions options;
+  options.max_length = 4;
+  const Expression::ExpressionMap terms =
+      NormalOrderer(Term(1.0, operators), options).terms();
+  EXPECT_FALSE(terms.empty());
+  for (const auto& [ops, coefficient] : terms) {
+    EXPECT_EQ(ops.size(), 4);
+  }
+  // Nothing short enough is reachable, so the string is never expanded.
+  options.max_length = 2;
+  EXPECT_TRUE(NormalOrderer(Term(1.0, operators), options).terms().empty());
+}
+
+TEST(NormalOrderTest, TruncationByThreshold) {
+  const Term large = one_body<Fermion>(1.0, Up, 0, Up, 1);
+  const Term small = one_body<Fermion>(1e-12, Up, 1, Up, 0);
+  NormalOrderOptions options;
+  options.threshold = 1e-9;
+  EXPECT_EQ(
+      NormalOrderer(std::vector<Term>{large, small}, options).expression(),
+      Expression(std::vector<Term>{large}));
+
+  // [c^dagger_0 c_1, c^dagger_1 c_0] = n_0 - n_1; the terms that cancel in
+  // the commutator are dropped too.
+  const Expression commutator = commute(
+      Expression(std::vector<Term>{large}),
+      Expression(std::vector<Term>{one_body<Fermion>(1.0, Up, 1, Up, 0)}),
+      options);
+  EXPECT_EQ(
+      commutator.terms(),
+      Expression(std::vector<Term>{
+                     one_body<Fermion>(1.0, Up, 0, Up, 0),
+                     one_body<Fermion>(-1.0, Up, 1, Up, 1)})
+          .terms());
+}
@@ -0,0 +1,123 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "ObservableSet.h"
+
+#include <gtest/gtest.h>
+
+#include <cmath>
+
+#include "BosonicBasis.h"
+#include "FermionicBasis.h"
+
+namespace {
+
+constexpr auto Fermion = Operator::Statistics::Fermion;
+constexpr auto Boson = Operator::Statistics::Boson;
+constexpr auto Up = Operator::Spin::Up;
+constexpr auto Down = Operator::Spin::Down;
+
+StateVector test_state(const Basis& basis) {
+  StateVector state(basis);
+  for (std::size_t k = 0; k < state.size(); k++) {
+    const auto x = static_cast<double>(k);
+    state[k] = {std::sin(x), std::cos(3.0 * x)};
+  }
+  state.normalize();
+  return state;
+}
+
+void expect_matches_single(
+    const std::vector<Expression>& observables, const StateVector& state) {
+  ObservableSet set(observables);
+  const std::vector<Complex> values = set.expectation(state);
+  ASSERT_EQ(values.size(), observables.size());
+  for (std::size_t i = 0; i < observables.size(); i++) {
+    EXPECT_NEAR(std::abs(values[i] - state.expectation(observables[i])), 0.0,
+                1e-12)
+        << "observable " << i;
+  }
+}
+
+}  // namespace
+
+TEST(ObservableSetTest, SpinCorrelations) {
+  const std::size_t sites = 5;
+  FermionicBasis basis(sites, 5);
+  const StateVector state = test_state(basis);
+
+  std::vector<Expression> observables;
+  for (std::size_t i = 0; i < sites; i++) {
+    for (std::size_t j = 0; j < sites; j++) {
+      // S_i . S_j = S^z_i S^z_j + (S^+_i S^-_j + S^-_i S^+_j) / 2.
+      std::vector<Term> terms;
+      for (auto s : {Up, Down}) {
+        for (auto t : {Up, Down}) {
+          const double sign = s == t ? 0.25 : -0.25;
+          terms.push_back(density_density<Fermion>(sign, s, i, t, j));
+        }
+      }
+      terms.push_back(two_body<Fermion>(0.5, Up, i, Down, i, Down, j, Up, j));
+      terms.push_back(two_body<Fermion>(0.5, Down, i, Up, i, Up, j, Down, j));
+      observables.emplace_back(terms);
+    }
+  }
+  expect_matches_single(observables, state);
+}
+
+TEST(ObservableSetTest, SharedStringsAndMixedTerms) {
+  const std::size_t sites = 4;
+  FermionicBasis basis(sites, 4);
+  const StateVector state = test_state(basis);
+
+  std::vector<Term> hamiltonian;
+  for (std::size_t i = 0; i < sites; i++) {
+    const std::size_t j = (i + 1) % sites;
+    for (auto s : {Up, Down}) {
+      hamiltonian.push_back(one_body<Fermion>(-1.0, s, i, s, j));
+      hamiltonian.push_back(one_body<Fermion>(-1.0, s, j, s, i));
+    }
+    hamiltonian.push_back(density_density<Fermion>(4.0, Up, i, Down, i));
+  }
+  std::vector<Expression> observables = {Expression(hamiltonian)};
+  for (std::size_t i = 0; i < sites; i++) {
+    for (std::size_t j = 0; j < sites; j++) {
+      // <c^dagger_i c_j>, which share their strings with the Hamiltonian.
+      observables.emplace_back(
+          std::vector<Term>{one_body<Fermion>(1.0, Up, i, Up, j)});
+      observables.emplace_back(
+          std::vector<Term>{density_density<Fermion>(1.0, Up, i, Down, j)});
+    }
+  }
+  // A constant, and a string of three creation and three annihilation
+  // operators.
+  observables.emplace_back(std::vector<Term>{Term(2.0, {})});
+  observables.emplace_back(std::vector<Term>{Term(
+      {0.5, 0.25},
+      {Operator::creation<Fermion>(Up, 0), Operator::creation<Fermion>(Up, 1),
+       Operator::creation<Fermion>(Down, 2),
+       Operator::annihilation<Fermion>(Down, 3),
+       Operator::annihilation<Fermion>(Up, 3),
+       Operator::annihilation<Fermion>(Up, 2)})});
+  expect_matches_single(observables, state);
+
+  const std::vector<Complex> values = ObservableSet(observables)
+                                          .expectation(state);
+  EXPECT_NEAR(std::abs(values[values.size() - 2] - 2.0), 0.0, 1e-12);
+}
+
+TEST(ObservableSetTest, BosonicObservables) {
+  BosonicBasis basis(3, 3);
+  const StateVector state = test_state(basis);
+  std::vector<Expression> observables;
+  for (std::size_t i = 0; i < 3; i++) {
+    observables.emplace_back(
+        std::vector<Term>{one_body<Boson>(1.0, Up, i, Up, (i + 1) % 3)});
+    observables.emplace_back(
+        std::vector<Term>{density_density<Boson>(1.0, Up, i, Up, i)});
+  }
+  // A fermionic observable, which is zero on bosonic states.
+  observables.emplace_back(
+      std::vector<Term>{one_body<Fermion>(1.0, Up, 0, Up, 1)});
+  expect_matches_single(observables, state);
+}
@@ -0,0 +1,29 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "ParallelSort.h"
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <utility>
+
+TEST(ParallelSortTest, MatchesStableSort) {
+  std::vector<std::size_t> sizes = {0, 1, 100, 10000, 100000};
+  for (std::size_t size : sizes) {
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> dist(0, 100);
+    std::vector<std::pair<int, std::size_t>> values;
+    for (std::size_t i = 0; i < size; i++) {
+      values.emplace_back(dist(rng), i);
+    }
+
+    // Compare only the first component so that ties exercise stability.
+    auto comp = [](const auto& a, const auto& b) { return a.first < b.first; };
+    std::vector<std::pair<int, std::size_t>> expected = values;
+    std::stable_sort(expected.begin(), expected.end(), comp);
+    parallel_sort(values.begin(), values.end(), comp);
+
+    EXPECT_EQ(values, expected);
+  }
+}
@@ -0,0 +1,76 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "SellMatrix.h"
+
+#include <gtest/gtest.h>
+
+#include "FermionicBasis.h"
+#include "Models/HubbardSquare.h"
+
+namespace {
+
+using Complex = std::complex<double>;
+
+std::vector<SellMatrix::Kernel> supported_kernels() {
+  std::vector<SellMatrix::Kernel> kernels = {SellMatrix::Kernel::Scalar};
+  for (auto kernel : {SellMatrix::Kernel::Avx2, SellMatrix::Kernel::Avx512}) {
+    if (kernel <= SellMatrix::best_kernel()) {
+      kernels.push_back(kernel);
+    }
+  }
+  return kernels;
+}
+
+void expect_same_product(
+    const CsrMatrix<Complex>& matrix, const SellMatrix& sell) {
+  std::vector<Complex> x(matrix.cols());
+  for (std::size_t k = 0; k < x.size(); k++) {
+    x[k] = {std::sin(static_cast<double>(k)), std::cos(static_cast<double>(k))};
+  }
+  std::vector<Complex> expected(matrix.rows());
+  matrix.multiply(x, expected);
+  for (auto kernel : supported_kernels()) {
+    std::vector<Complex> y(matrix.rows(), Complex{1.0, 1.0});
+    sell.multiply(x, y, kernel);
+    for (std::size_t k = 0; k < y.size(); k++) {
+      EXPECT_NEAR(std::abs(y[k] - expected[k]), 0.0, 1e-12);
+    }
+  }
+}
+
+}  // namespace
+
+TEST(SellMatrixTest, HubbardSquare) {
+  HubbardSquare model(1.0, 4.0, 2, 3);
+  FermionicBasis basis(model.size(), 5);
+  CsrMatrix<Complex> matrix = model.matrix(basis);
+  const std::vector<std::size_t> sigmas = {8, 64, 1024};
+  for (std::size_t sigma : sigmas) {
+    SellMatrix sell(matrix, sigma);
+    EXPECT_EQ(sell.nonzeros(), matrix.nonzeros());
+    EXPECT_GE(sell.stored(), matrix.nonzeros());
+    expect_same_product(matrix, sell);
+  }
+}
+
+TEST(SellMatrixTest, IrregularRows) {
+  // 21 rows, not a multiple of the chunk size, with lengths from 0 to 6.
+  const std::size_t rows = 21;
+  const std::size_t cols = 13;
+  std::vector<std::size_t> offsets = {0};
+  std::vector<std::size_t> columns;
+  std::vector<Complex> values;
+  for (std::size_t r = 0; r < rows; r++) {
+    for (std::size_t j = 0; j < (r * 5) % 7; j++) {
+      columns.push_back((r + 2 * j) % cols);
+      values.push_back({static_cast<double>(r), -static_cast<double>(j)});
+    }
+    std::sort(
+        columns.end() - static_cast<std::ptrdiff_t>((r * 5) % 7),
+        columns.end());
+    offsets.push_back(columns.size());
+  }
+  CsrMatrix<Complex> matrix(cols, offsets, columns, values);
+  expect_same_product(matrix, SellMatrix(matrix, 16));
+}
@@ -0,0 +1,103 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "SeparableMatrix.h"
+
+#include <gtest/gtest.h>
+
+#include "FermionicBasis.h"
+#include "Models/HubbardChain.h"
+#include "Models/HubbardChainKSpace.h"
+#include "Models/HubbardSquare.h"
+#include "Models/LinearChain.h"
+
+namespace {
+
+void expect_same_matrix(
+    const CsrMatrix<std::complex<double>>& actual,
+    const CsrMatrix<std::complex<double>>& expected) {
+  ASSERT_EQ(actual.rows(), expected.rows());
+  for (std::size_t r = 0; r < expected.rows(); r++) {
+    for (std::size_t e = expected.row_offsets()[r];
+         e < expected.row_offsets()[r + 1]; e++) {
+      EXPECT_NEAR(
+          std::abs(actual(r, expected.columns()[e]) - expected.values()[e]),
+          0.0, 1e-12);
+    }
+    for (std::size_t e = actual.row_offsets()[r];
+         e < actual.row_offsets()[r + 1]; e++) {
+      EXPECT_NEAR(
+          std::abs(actual.values()[e] - expected(r, actual.columns()[e])),
+          0.0, 1e-12);
+    }
+  }
+}
+
+class TwoSiteModel final : public Model {
+ private:
+  std::vector<Term> hamiltonian() const override {
+    return {one_body<Operator::Statistics::Fermion>(
+        1.0, Operator::Spin::Up, 0, Operator::Spin::Up, 1)};
+  }
+};
+
+}  // namespace
+
+TEST(SeparableMatrixTest, PartsSumToHamiltonian) {
+  HubbardChain chain(1.0, 4.0, 6);
+  FermionicBasis chain_basis(6, 4);
+  expect_same_matrix(
+      SeparableMatrix(chain, chain_basis).assemble(chain),
+      chain.matrix(chain_basis));
+
+  HubbardSquare square(0.5, 2.0, 2, 3);
+  FermionicBasis square_basis(6, 5);
+  expect_same_matrix(
+      SeparableMatrix(square, square_basis).assemble(square),
+      square.matrix(square_basis));
+
+  HubbardChainKSpace kspace(1.0, 2.0, 4, 3);
+  FermionicBasis kspace_basis(4, 3);
+  expect_same_matrix(
+      SeparableMatrix(kspace, kspace_basis).assemble(kspace),
+      kspace.matrix(kspace_basis));
+
+  LinearChain linear(5, 1.0, 0.3);
+  FermionicBasis linear_basis(5, 2);
+  expect_same_matrix(
+      SeparableMatrix(linear, linear_basis).assemble(linear),
+      linear.matrix(linear_basis));
+}
+
+TEST(SeparableMatrixTest, ParameterSweep) {
+  FermionicBasis basis(6, 6);
+  SeparableMatrix separable(HubbardChain(1.0, 0.0, 6), basis);
+  EXPECT_EQ(separable.names(), std::vector<std::string>({"t", "u"}));
+
+  for (double u : {0.0, 2.0, 8.0}) {
+    HubbardChain model(0.5, u, 6);
+    CsrMatrix<std::complex<double>> expected = model.matrix(basis);
+    expect_same_matrix(separable.assemble(model), expected);
+
+    std::vector<std::complex<double>> x(basis.size());
+    for (std::size_t k = 0; k < x.size(); k++) {
+      x[k] = {std::cos(static_cast<double>(k)), 0.5};
+    }
+    std::vector<std::complex<double>> y(basis.size());
+    std::vector<std::complex<double>> y_expected(basis.size());
+    separable.multiply(separable.coefficients(model), x, y);
+    expected.multiply(x, y_expected);
+    for (std::size_t k = 0; k < y.size(); k++) {
+      EXPECT_NEAR(std::abs(y[k] - y_expected[k]), 0.0, 1e-12);
+    }
+  }
+}
+
+TEST(SeparableMatrixTest, DefaultSinglePart) {
+  TwoSiteModel model;
+  FermionicBasis basis(2, 1);
+  SeparableMatrix separable(model, basis);
+  EXPECT_EQ(separable.names().size(), 1);
+  expect_same_matrix(separable.assemble({1.0}), model.matrix(basis));
+  EXPECT_EQ(separable.assemble({2.0})(0, 2), 2.0);
+}
@@ -0,0 +1,94 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "StateVector.h"
+
+#include <gtest/gtest.h>
+
+#include "FermionicBasis.h"
+#include "Models/HubbardChain.h"
+
+namespace {
+
+constexpr auto Fermion = Operator::Statistics::Fermion;
+constexpr auto Up = Operator::Spin::Up;
+
+StateVector test_state(const Basis& basis) {
+  StateVector state(basis);
+  for (std::size_t k = 0; k < state.size(); k++) {
+    state[k] = {std::sin(static_cast<double>(k)), 0.5};
+  }
+  state.normalize();
+  return state;
+}
+
+}  // namespace
+
+TEST(StateVectorTest, VectorOperations) {
+  FermionicBasis basis(3, 2);
+  StateVector a = test_state(basis);
+  StateVector b = StateVector::basis_state(basis, 4);
+  EXPECT_NEAR(a.norm(), 1.0, 1e-12);
+  EXPECT_NEAR(std::abs(a.overlap(b) - std::conj(a[4])), 0.0, 1e-12);
+
+  StateVector c = a;
+  c.axpy(-a[4], b);
+  EXPECT_NEAR(std::abs(c[4]), 0.0, 1e-12);
+  c.scale(2.0);
+  EXPECT_NEAR(std::abs(c[0] - 2.0 * a[0]), 0.0, 1e-12);
+}
+
+TEST(StateVectorTest, ApplyHamiltonian) {
+  HubbardChain model(1.0, 4.0, 4);
+  FermionicBasis basis(4, 3);
+  StateVector state = test_state(basis);
+
+  StateVector result = state.apply(model.compiled_hamiltonian(), basis);
+  ComplexVector expected(basis.size());
+  model.apply(basis, state.amplitudes(), expected);
+  for (std::size_t k = 0; k < basis.size(); k++) {
+    EXPECT_NEAR(std::abs(result[k] - expected[k]), 0.0, 1e-12);
+  }
+  EXPECT_NEAR(
+      std::abs(state.expectation(model.compiled_hamiltonian()) -
+               state.overlap(result)),
+      0.0, 1e-12);
+}
+
+TEST(StateVectorTest, ApplyBetweenSectors) {
+  // c c^dagger |psi> = (1 - n) |psi>, going through the sector with one more
+  // particle.
+  FermionicBasis basis(3, 2);
+  FermionicBasis more(3, 3);
+  StateVector state = test_state(basis);
+  const Expression create(
+      std::vector<Term>{Term(1.0, {Operator::creation<Fermion>(Up, 1)})});
+  const Expression annihilate(
+      std::vector<Term>{Term(1.0, {Operator::annihilation<Fermion>(Up, 1)})});
+  const Expression number(
+      std::vector<Term>{one_body<Fermion>(1.0, Up, 1, Up, 1)});
+
+  StateVector added = state.apply(create, more);
+  EXPECT_EQ(&added.basis(), &more);
+  StateVector result = added.apply(annihilate, basis);
+  StateVector expected = state;
+  expected.axpy(-1.0, state.apply(number));
+  for (std::size_t k = 0; k < basis.size(); k++) {
+    EXPECT_NEAR(std::abs(result[k] - expected[k]), 0.0, 1e-12);
+  }
+  EXPECT_NEAR(
+      added.norm() * added.norm(),
+      1.0 - state.expectation(number).real(), 1e-12);
+}
+
+TEST(StateVectorTest, DominantTerms) {
+  FermionicBasis basis(2, 2);
+  StateVector state(basis);
+  state[1] = 0.1;
+  state[3] = -0.9;
+  state[4] = 0.5;
+  std::vector<Term> terms = state.dominant_terms(2);
+  ASSERT_EQ(terms.size(), 2);
+  EXPECT_EQ(terms[0], Term(-0.9, basis.element(3)));
+  EXPECT_EQ(terms[1], Term(0.5, basis.element(4)));
+}
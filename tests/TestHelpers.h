@@ -0,0 +1,56 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#pragma once
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#include "CsrMatrix.h"
+#include "LinearAlgebra.h"
+#include "LinearOperator.h"
+#include "Model.h"
+
+// Column-major dense copy of `matrix`, as hermitian_eigen() expects.
+inline ComplexVector dense_matrix(const CsrMatrix<Complex>& matrix) {
+  const std::size_t n = matrix.rows();
+  ComplexVector dense(n * matrix.cols());
+  for (std::size_t r = 0; r < n; r++) {
+    for (std::size_t k = matrix.row_offsets()[r];
+         k < matrix.row_offsets()[r + 1]; k++) {
+      dense[r + matrix.columns()[k] * n] = matrix.values()[k];
+    }
+  }
+  return dense;
+}
+
+// Eigenpairs of `matrix` by dense diagonalisation.
+inline HermitianEigen dense_eigen(const CsrMatrix<Complex>& matrix) {
+  return hermitian_eigen(dense_matrix(matrix), matrix.rows());
+}
+
+// Eigenvalues of the matrix of `model` on `basis`, by dense diagonalisation.
+inline std::vector<double> dense_eigenvalues(
+    const Model& model, const Basis& basis) {
+  return dense_eigen(model.matrix(basis)).values;
+}
+
+// Checks the lowest `roots` eigenpairs of an iterative solver against the
+// exact eigenvalues and the residual bound the solvers converge to.
+inline void expect_eigenpairs(
+    const LinearOperator& op, const EigenResult& result,
+    const std::vector<double>& expected, std::size_t roots) {
+  ASSERT_TRUE(result.converged);
+  ASSERT_EQ(result.values.size(), roots);
+  for (std::size_t i = 0; i < roots; i++) {
+    EXPECT_NEAR(result.values[i], expected[i], 1e-8);
+    ComplexVector y;
+    op.apply(result.vectors[i], y);
+    axpy(-result.values[i], result.vectors[i], y);
+    EXPECT_LT(norm(y), 2e-9 * std::max(1.0, std::abs(result.values[i])));
+    EXPECT_NEAR(norm(result.vectors[i]), 1.0, 1e-12);
+  }
+}
@@ -0,0 +1,103 @@
+// Copyright (c) 2024 Matheus Sousa
+// SPDX-License-Identifier: BSD-2-Clause
+
+#include "TimeEvolution.h"
+
+#include <gtest/gtest.h>
+
+#include "FermionicBasis.h"
+#include "Models/HubbardChain.h"
+#include "TestHelpers.h"
+
+namespace {
+
+// exp(-i H t) psi by dense diagonalisation.
+ComplexVector exact_evolution(
+    const CsrMatrix<Complex>& matrix, const ComplexVector& psi, double time) {
+  const std::size_t n = matrix.rows();
+  const HermitianEigen eigen = dense_eigen(matrix);
+  ComplexVector result(n);
+  for (std::size_t l = 0; l < n; l++) {
+    Complex overlap{};
+    for (std::size_t i = 0; i < n; i++) {
+      overlap += std::conj(eigen.vectors[i + l * n]) * psi[i];
+    }
+    overlap *= std::polar(1.0, -eigen.values[l] * time);
+    for (std::size_t i = 0; i < n; i++) {
+      result[i] += overlap * eigen.vectors[i + l * n];
+    }
+  }
+  return result;
+}
+
+ComplexVector initial_state(std::size_t n) {
+  std::mt19937_64 rng(3);
+  ComplexVector psi = random_vector(n, rng);
+  scale(1.0 / norm(psi), psi);
+  return psi;
+}
+
+}  // namespace
+
+TEST(TimeEvolutionTest, MatchesExactEvolution) {
+  HubbardChain model(1.0, 4.0, 4);
+  FermionicBasis basis(4, 4);
+  const CsrMatrix<Complex> matrix = model.matrix(basis);
+  LinearOperator op(matrix);
+
+  ComplexVector psi = initial_state(basis.size());
+  const ComplexVector expected = exact_evolution(matrix, psi, 3.0);
+  TimeEvolutionOptions options;
+  options.krylov_dimension = 12;
+  TimeEvolutionResult result = evolve(op, psi, 3.0, options);
+
+  // The step length is limited by the small Krylov space.
+  EXPECT_TRUE(result.completed);
+  EXPECT_GT(result.steps, 1);
+  EXPECT_LE(result.error, result.steps * options.tolerance);
+  ComplexVector difference = psi;
+  axpy(-1.0, expected, difference);
+  EXPECT_LT(norm(difference), 1e-8);
+  EXPECT_NEAR(norm(psi), 1.0, 1e-10);
+}
+
+TEST(TimeEvolutionTest, SmallestKrylovSpace) {
+  HubbardChain model(1.0, 4.0, 4);
+  FermionicBasis basis(4, 4);
+  const CsrMatrix<Complex> matrix = model.matrix(basis);
+  LinearOperator op(matrix);
+
+  ComplexVector psi = initial_state(basis.size());
+  const ComplexVector expected = exact_evolution(matrix, psi, 0.1);
+  TimeEvolutionOptions options;
+  options.krylov_dimension = TimeEvolutionOptions::min_krylov_dimension;
+  TimeEvolutionResult result = evolve(op, psi, 0.1, options);
+
+  EXPECT_TRUE(result.completed);
+  EXPECT_LE(result.error, result.steps * options.tolerance);
+  ComplexVector difference = psi;
+  axpy(-1.0, expected, difference);
+  EXPECT_LT(norm(difference), 1e-8);
+}
+
+TEST(TimeEvolutionTest, ForwardAndBackward) {
+  HubbardChain model(1.0, 2.0, 4);
+  FermionicBasis basis(4, 3);
+  LinearOperator op(model, basis);
+
+  const ComplexVector psi0 = initial_state(basis.size());
+  ComplexVector psi = psi0;
+  ComplexVector h_psi;
+  op.apply(psi, h_psi);
+  const double energy = dot(psi, h_psi).real();
+
+  for (std::size_t step = 0; step < 10; step++) {
+    evolve(op, psi, 0.5);
+  }
+  op.apply(psi, h_psi);
+  EXPECT_NEAR(dot(psi, h_psi).real(), energy, 1e-9);
+
+  evolve(op, psi, -5.0);
+  axpy(-1.0, psi0, psi);
+  EXPECT_LT(norm(psi), 1e-8);
+}